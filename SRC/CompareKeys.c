@@ -6,6 +6,10 @@
 *    stored key, and '2' if the new key is lexicographically more      *
 *    than the stored key.                                              *
 *                                                                      *
+*    The page searches use SlotCompare() (slotpage.c) directly, on     *
+*    keys of known length; this is the version for terminated          *
+*    strings, which stops at the first difference.                     *
+*                                                                      *
 ***********************************************************************/
 
 #include "def.h"
@@ -14,20 +18,14 @@
 /* Key:  Possible New Key */
 /* Word: The Key Stored in the B-Tree */
 int CompareKeys(char *Key, char *Word) {
-
-    int m = max(strlen(Key), strlen(Word));
-
-    int i = 0;
-    for (i = 0; i < m; i++) {
-        if (i >= strlen(Key)) {
-            return (1);
-        } else if (i >= strlen(Word)) {
-            return (2);
-        } else if (Key[i] < Word[i]) {
-            return (1);
-        } else if (Key[i] > Word[i]) {
-            return (2);
-        }
+    /* one pass over the common part; no strlen() needed */
+    while ((*Key == *Word) && (*Key != EOS)) {
+        Key++;
+        Word++;
     }
+    if ((unsigned char) *Key < (unsigned char) *Word)
+        return (1);
+    else if ((unsigned char) *Key > (unsigned char) *Word)
+        return (2);
     return (0);
 }
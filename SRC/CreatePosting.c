@@ -2,30 +2,34 @@
 
 #include "def.h"
 
-extern FILE *fppost;
-extern int pWriteCount;
-
 extern POSTINGSPTR getrec(long int size);
-
-void CreatePosting(TEXTPTR TextOffset, POSTINGSPTR *pPostOffset) {
-    NUMPTRS NumPtrs;
-    TEXTPTR SpaceFiller;
-    int i;
-
-    NumPtrs = 1;
-    SpaceFiller = 0;
+extern long PostEncode(DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where,
+                       NUMPTRS Num, unsigned char *Buf);
+extern void PostWrite(POSTINGSPTR pptr, struct PostHdr *Hdr,
+                      unsigned char *Buf, long Len);
+
+/* creates the postings record of a new key, with the postings 'New' */
+void CreatePosting(struct PostBatch *New, POSTINGSPTR *pPostOffset) {
+    struct PostHdr hdr;
+    unsigned char *ptr;
+    long npos = 0;
+    NUMPTRS i;
+
+    for (hdr.MaxTf = 0, i = 0; i < New->Num; i++) {
+        hdr.MaxTf = max(hdr.MaxTf, New->Tfs[i]);
+        npos += New->Tfs[i];
+    }
+    ptr = (unsigned char *) malloc(PostBytes(New->Num, POSITIONS ? npos : 0));
+    ck_malloc(ptr, "ptr in CreatePosting()");
+
+    /* the first document is coded as itself (see postrec.c) */
+    hdr.NumPtrs = New->Num;
+    hdr.NumBytes = PostEncode(New->Docs, New->Tfs, New->Where, New->Num, ptr);
 
     /* get a posting block of minimum size */
-    *pPostOffset = getrec(1);
+    *pPostOffset = getrec(hdr.NumBytes);
 
     /* Write the new posting to disk */
-    pWriteCount++; /* counts number of disk writes */
-    fseek(fppost, (long) *pPostOffset, 0);
-    fwrite(&NumPtrs, sizeof(NumPtrs), 1, fppost);
-    fwrite(&TextOffset, sizeof(TextOffset), 1, fppost);
-
-    /* fill in any extra space with filler */
-    /* this should not be executed if first listsize is 1 */
-    for (i = NumPtrs; i < MAXTEXTPTRS; i++)
-        fwrite(&SpaceFiller, sizeof(SpaceFiller), 1, fppost);
+    PostWrite(*pPostOffset, &hdr, ptr, hdr.NumBytes);
+    free(ptr);
 }
@@ -13,6 +13,7 @@
 extern FILE *fpbtree;
 
 extern void FlushPage(struct PageHdr *PagePtr);
+extern PAGENO getNewPageNum(void);
 
 void CreateRoot(void) {
     struct PageHdr *PagePtr;
@@ -21,9 +22,12 @@ void CreateRoot(void) {
     PagePtr = (struct PageHdr *) malloc(sizeof(struct PageHdr));
     ck_malloc(PagePtr, "PagePtr");
     PagePtr->PgTypeID = LeafSymbol;
-    PagePtr->PgNum = ROOT;
+    PagePtr->PgNum = getNewPageNum();
+    SuperBlk.RootPg = PagePtr->PgNum;
+    SuperBlk.Height = 1;
     PagePtr->PgNumOfNxtLfPg = NULLPAGENO;
     PagePtr->KeyListPtr = NULL; /* no keys yet */
+    PagePtr->PinnedFrame = NOFRAME;
 
     FlushPage(PagePtr); /* fills in #bytes & #keys */
 }
@@ -1,10 +1,15 @@
 /****************************************************************************
 *                                                                           *
-*     The function FetchPage reads a page from disk using the formula       *
-*     PageNum * PAGESIZE - PAGESIZE, e.g., if the PageNum = 3 and           *
-*     PAGESIZE = 1024, the B-Tree file will be accessed starting at         *
-*     offset 2048, wherein the first page would be stored at offset 0,      *
-*     and the second page at offset 1024.                                   *
+*     The function FetchPage reads a page from disk at the offset           *
+*     PageNum * PAGESIZE, e.g., if the PageNum = 3 and PAGESIZE = 1024,     *
+*     the B-Tree file will be accessed starting at offset 3072.  Page 0,    *
+*     at offset 0, is the superblock (see superblock.c), so the first       *
+*     page of the tree is page 1, at offset 1024.                           *
+*                                                                           *
+*     The page image is obtained through the buffer pool (bufpool.c),       *
+*     so the disk is read only when the page is not already cached.         *
+*     The frame stays pinned until the page is released.  The image is      *
+*     a slotted page (see slotpage.c); the keys are copied out of it.       *
 *                                                                           *
 *     FetchPage installs the page in the following structures:              *
 *                                                                           *
@@ -52,17 +57,23 @@
 
 #include "def.h"
 
-extern FILE *fpbtree;
 extern int btReadCount;
 
-struct PageHdr *FetchPage(PAGENO Page)
-/* Page number of page to be fetched */
-{
-    struct PageHdr *PagePtr;
-    struct KeyRecord *KeyNode,
-        *KeyListTraverser; /* To traverse the list of keys */
+extern int BufPin(PAGENO Page, int Load);
+extern char *BufImage(int f);
+extern int SlotNumKeys(char *Page);
+extern PAGENO SlotPgNum(char *Page);
+extern PAGENO SlotLink(char *Page);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern long SlotPtr(char *Page, int i);
+extern int SlotBytes(char *Page);
 
-    int i;
+/* pins page 'Page' and returns its image, for the callers that work
+   on the page in place (see slotpage.c) instead of building the list
+   of keys.  The frame is returned in *pFrame; the caller releases it
+   with BufUnpin(). */
+char *PinPage(PAGENO Page, int *pFrame) {
+    char *Image;
     PAGENO FindNumPagesInTree(void);
 
     // update fetch counts
@@ -75,27 +86,41 @@ struct PageHdr *FetchPage(PAGENO Page)
         /*	exit(-1); */
     }
 
-    /* Read in the page header */
-    PagePtr = (struct PageHdr *) malloc(sizeof(*PagePtr));
-    ck_malloc(PagePtr, "PagePtr");
-    fseek(fpbtree, (long) Page * PAGESIZE - PAGESIZE, 0);
-
-    fread(&PagePtr->PgTypeID, sizeof(char), 1, fpbtree);
-    fread(&PagePtr->PgNum, sizeof(PagePtr->PgNum), 1, fpbtree);
-    if ((PagePtr->PgNum) != Page) {
+    *pFrame = BufPin(Page, TRUE);
+    Image = BufImage(*pFrame);
+    if (SlotPgNum(Image) != Page) {
         printf("FetchPage: corrupted Page %d\n", (int) Page);
         exit(-1);
     }
+    return (Image);
+}
+
+struct PageHdr *FetchPage(PAGENO Page)
+/* Page number of page to be fetched */
+{
+    struct PageHdr *PagePtr;
+    struct KeyRecord *KeyNode,
+        *KeyListTraverser; /* To traverse the list of keys */
+    char *Image;           /* the page image, in the buffer pool */
+    char *Word;
 
+    int i;
+
+    /* Read in the page header; the frame stays pinned until the
+       page is released by FreePage() or FlushPage() */
+    PagePtr = (struct PageHdr *) malloc(sizeof(*PagePtr));
+    ck_malloc(PagePtr, "PagePtr");
+    Image = PinPage(Page, &PagePtr->PinnedFrame);
+
+    PagePtr->PgTypeID = Image[SP_TYPE];
+    PagePtr->PgNum = Page;
     if (IsLeaf(PagePtr))
-        fread(&PagePtr->PgNumOfNxtLfPg, sizeof(PagePtr->PgNumOfNxtLfPg), 1,
-              fpbtree);
-    fread(&PagePtr->NumBytes, sizeof(PagePtr->NumBytes), 1, fpbtree);
-    fread(&PagePtr->NumKeys, sizeof(PagePtr->NumKeys), 1, fpbtree);
-    PagePtr->KeyListPtr = NULL;
+        PagePtr->PgNumOfNxtLfPg = SlotLink(Image);
     if (IsNonLeaf(PagePtr))
-        fread(&PagePtr->PtrToFinalRtgPg, sizeof(PagePtr->PtrToFinalRtgPg), 1,
-              fpbtree);
+        PagePtr->PtrToFinalRtgPg = SlotLink(Image);
+    PagePtr->NumBytes = SlotBytes(Image);
+    PagePtr->NumKeys = SlotNumKeys(Image);
+    PagePtr->KeyListPtr = NULL;
 
     /* Read in the keys */
     KeyListTraverser = NULL;
@@ -103,15 +128,15 @@ struct PageHdr *FetchPage(PAGENO Page)
         KeyNode = (struct KeyRecord *) malloc(sizeof(*KeyNode));
         ck_malloc(KeyNode, "KeyNode");
         if (IsNonLeaf(PagePtr))
-            fread(&KeyNode->PgNum, sizeof(KeyNode->PgNum), 1, fpbtree);
-        fread(&KeyNode->KeyLen, sizeof(KeyNode->KeyLen), 1, fpbtree);
+            KeyNode->PgNum = SlotPtr(Image, i);
+        Word = SlotKey(Image, i, &KeyNode->KeyLen);
         KeyNode->StoredKey = (char *) malloc((KeyNode->KeyLen) + 1);
         ck_malloc(KeyNode->StoredKey, "KeyNode->StoredKey in FetchPage()");
-        fread(KeyNode->StoredKey, sizeof(char), KeyNode->KeyLen, fpbtree);
+        memcpy(KeyNode->StoredKey, Word, KeyNode->KeyLen);
         (*(KeyNode->StoredKey + KeyNode->KeyLen)) =
             '\0'; /* string terminator */
         if (IsLeaf(PagePtr))
-            fread(&KeyNode->Posting, sizeof(KeyNode->Posting), 1, fpbtree);
+            KeyNode->Posting = SlotPtr(Image, i);
         if (KeyListTraverser == NULL) {
             KeyListTraverser = KeyNode;
             PagePtr->KeyListPtr = KeyNode;
@@ -1,14 +1,13 @@
 /**************************************************************************
  returns the number of pages currently in the B-tree
+ (pages still waiting in the buffer pool are counted, too)
 **************************************************************************/
 
 #include "def.h"
-extern FILE *fpbtree;
 
 PAGENO FindNumPagesInTree(void) {
     PAGENO num;
-    long ffsize(FILE * fp);
 
-    num = (PAGENO) ffsize(fpbtree) / PAGESIZE;
+    num = SuperBlk.NumPages; /* kept in the superblock */
     return (num);
 }
@@ -1,29 +1,34 @@
 
 /*************************************************************************
 *                                                                        *
-*    This function writes a page to disk and then calls function         *
-*    FreePage to free the storage space that was allocated to the       *
-*    dynamic data structures.                                            *
+*    This function writes a page into its buffer-pool frame, marks       *
+*    the frame dirty, and then calls function FreePage to free the       *
+*    storage space that was allocated to the dynamic data structures.    *
+*    The page reaches the disk when the frame is evicted or the pool     *
+*    is flushed (see bufpool.c).                                         *
 *                                                                        *
-*    The size of the page, PAGESIZE, is locked-in when the page is       *
-*    written to disk.  This is handled by the padding of character       *
-*    zero's, e.g., if PAGESIZE = x and the number of bytes that are      *
-*    stored in the page is NumBytes = n, there will be (x - n)           *
-*    character byte zero's written to disk.                              *
+*    The page is laid out as a slotted page (see slotpage.c); the        *
+*    size of the page, PAGESIZE, is locked-in when the page is written   *
+*    to disk, with the free space between the slot array and the key     *
+*    heap in the middle.                                                 *
 *                                                                        *
 *************************************************************************/
 
 #include "def.h"
-extern FILE *fpbtree;
 extern int btWriteCount; /* counts the number of b-tree page writes */
 
 extern int fillIn(struct PageHdr *PagePtr);
 extern void FreePage(struct PageHdr *PagePtr);
+extern int BufPin(PAGENO Page, int Load);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern void SlotInit(char *Page, char Type, PAGENO PgNum, PAGENO Link);
+extern int SlotInsert(char *Page, int i, char *Key, int KeyLen, long Ptr);
 
 void FlushPage(struct PageHdr *PagePtr) {
     struct KeyRecord *KeyListTraverser; /* A pointer to the list of keys */
-    int i;
-    char Ch;
+    int Frame, i;
+    char *Image; /* the page image, in the buffer pool */
 
     fillIn(PagePtr); /* calculates the # of bytes and # of keys */
     if (PagePtr->NumBytes > PAGESIZE) {
@@ -33,52 +38,31 @@ void FlushPage(struct PageHdr *PagePtr) {
         exit(-2);
     }
 
-    fseek(fpbtree, (long) (PagePtr->PgNum) * PAGESIZE - PAGESIZE, 0);
+    /* the whole image is rewritten, so there is no need to read it */
+    Frame = BufPin(PagePtr->PgNum, FALSE);
+    Image = BufImage(Frame);
 #ifdef DEBUG
 
-    printf("FlushPage starting: ftell()=%ld for page # %d\n", ftell(fpbtree),
+    printf("FlushPage starting: frame %d for page # %d\n", Frame,
            (int) (PagePtr->PgNum));
 #endif
 
-    /* Write the page header to disk */
-    fwrite(&PagePtr->PgTypeID, sizeof(PagePtr->PgTypeID), 1, fpbtree);
-    fwrite(&PagePtr->PgNum, sizeof(PagePtr->PgNum), 1, fpbtree);
-    if (IsLeaf(PagePtr))
-        fwrite(&PagePtr->PgNumOfNxtLfPg, sizeof(PagePtr->PgNumOfNxtLfPg), 1,
-               fpbtree);
-    fwrite(&PagePtr->NumBytes, sizeof(PagePtr->NumBytes), 1, fpbtree);
-    fwrite(&PagePtr->NumKeys, sizeof(PagePtr->NumKeys), 1, fpbtree);
-    if (IsNonLeaf(PagePtr))
-        fwrite(&PagePtr->PtrToFinalRtgPg, sizeof(PagePtr->PtrToFinalRtgPg), 1,
-               fpbtree);
+    /* Write the page header to the image */
+    SlotInit(Image, PagePtr->PgTypeID, PagePtr->PgNum,
+             IsLeaf(PagePtr) ? PagePtr->PgNumOfNxtLfPg
+                             : PagePtr->PtrToFinalRtgPg);
 
-    /* Write the keys to disk */
-    for (KeyListTraverser = PagePtr->KeyListPtr; KeyListTraverser != NULL;
-         KeyListTraverser = KeyListTraverser->Next) {
-        if (IsNonLeaf(PagePtr))
-            fwrite(&KeyListTraverser->PgNum, sizeof(KeyListTraverser->PgNum), 1,
-                   fpbtree);
-        fwrite(&KeyListTraverser->KeyLen, sizeof(KeyListTraverser->KeyLen), 1,
-               fpbtree);
-        fwrite(KeyListTraverser->StoredKey, sizeof(char),
-               KeyListTraverser->KeyLen, fpbtree);
-        if (IsLeaf(PagePtr))
-            fwrite(&KeyListTraverser->Posting,
-                   sizeof(KeyListTraverser->Posting), 1, fpbtree);
+    /* Write the keys to the image, in order */
+    for (KeyListTraverser = PagePtr->KeyListPtr, i = 0;
+         KeyListTraverser != NULL;
+         KeyListTraverser = KeyListTraverser->Next, i++) {
+        SlotInsert(Image, i, KeyListTraverser->StoredKey,
+                   KeyListTraverser->KeyLen,
+                   IsLeaf(PagePtr) ? KeyListTraverser->Posting
+                                   : KeyListTraverser->PgNum);
     }
 
-    /* Lock-in full page size */
-    Ch = '0';
-    for (i = PagePtr->NumBytes; i < PAGESIZE; i++)
-        fwrite(&Ch, sizeof(Ch), 1, fpbtree);
-
-#ifdef DEBUG
-
-    printf("FlushPage ending: ftell()=%ld for page # %d\n", ftell(fpbtree),
-           (int) (PagePtr->PgNum));
-#endif
-
-    fflush(fpbtree); /* make sure the page is written back */
+    BufUnpin(Frame, TRUE); /* written back when the frame is evicted */
 
     /* Free core storage allocated for page header and keys */
     FreePage(PagePtr);
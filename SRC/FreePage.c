@@ -1,12 +1,14 @@
 /************************************************************************
 *                                                                       *
 *    This function frees the space that was dynamimcally secured to     *
-*    hold a disk page.                                                  *
+*    hold a disk page, and unpins its buffer-pool frame, if any.        *
 *                                                                       *
 ************************************************************************/
 
 #include "def.h"
 
+extern void BufUnpin(int f, int Dirty);
+
 void FreePage(struct PageHdr *PagePtr) {
     struct KeyRecord *nextVictim, /* Pointer to the list of keys */
         *currentVictim;           /* Pointer to the list of keys */
@@ -20,6 +22,10 @@ void FreePage(struct PageHdr *PagePtr) {
         free((char *) currentVictim);
     }
 
+    /* Release the frame pinned by FetchPage() */
+    if (PagePtr->PinnedFrame != NOFRAME)
+        BufUnpin(PagePtr->PinnedFrame, FALSE);
+
     /* Free the page header */
     free((char *) PagePtr);
 }
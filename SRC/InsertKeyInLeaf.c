@@ -3,68 +3,86 @@
 *   This function inserts a key into a leaf page, after a Posting has      *
 *   been created.  In the case where a key is already stored in the        *
 *   B-Tree, the Posting record is updated.                                 *
-    If the page overflows, it
-       splits it,
-       flushes the two new pages and
-       return the value of the middle key in a structure "upKey"
-    Otherwise, it just flushes back the old page and returns NULL
+*                                                                          *
+*   The page is given as the buffer-pool frame that holds it, pinned; the  *
+*   frame is released before returning.  The key is inserted in place, in  *
+*   the slot array of the page image (see slotpage.c).  If the page        *
+*   overflows, it                                                          *
+*      decodes the page into the list of keys, adds the key,               *
+*      splits it,                                                          *
+*      flushes the two new pages and                                       *
+*      return the value of the middle key in a structure "upKey"           *
+*   Otherwise, it returns NULL.                                            *
 *                                                                          *
 ***************************************************************************/
 
 #include "def.h"
 
-extern int UpdatePostingsFile(POSTINGSPTR *pPostOffset, TEXTPTR NewTextOffset);
-extern int FreePage(struct PageHdr *PagePtr);
-extern int FlushPage(struct PageHdr *PagePtr);
-extern int CreatePosting(TEXTPTR TextOffset, POSTINGSPTR *pPostOffset);
+extern int UpdatePostingsFile(POSTINGSPTR *pPostOffset,
+                              struct PostBatch *New);
+extern int CreatePosting(struct PostBatch *New, POSTINGSPTR *pPostOffset);
 extern int fillIn(struct PageHdr *PagePtr);
+extern struct PageHdr *FetchPage(PAGENO Page);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotSearch(char *Page, char *Key, int KeyLen, int *Found);
+extern int SlotInsert(char *Page, int i, char *Key, int KeyLen, long Ptr);
+extern long SlotPtr(char *Page, int i);
+extern void SlotSetPtr(char *Page, int i, long Ptr);
+extern PAGENO SlotPgNum(char *Page);
 
-struct upKey *InsertKeyInLeaf(struct PageHdr *PagePtr, char *Key,
-                              TEXTPTR TextOffset) {
+struct upKey *InsertKeyInLeaf(int Frame, char *Key, struct PostBatch *New) {
     struct KeyRecord *KeyListTraverser, /*                              */
         *KeyListTrailer,                /* Pointers to the list of keys */
         *NewKeyNode;
+    struct PageHdr *PagePtr;
 
     int InsertionPosition, /* Position for insertion */
-        Count, Found, i;
+        Found, i;
+    KEYLEN KeyLen;
     POSTINGSPTR PostOffset;
     struct upKey *MiddleKey, *SplitPage(struct PageHdr * PagePtr);
-    int FindInsertionPosition(struct KeyRecord * KeyListTraverser, char *Key,
-                              int *Found, NUMKEYS NumKeys, int Count);
     char *strsave(char *s);
-
-    Count = 0;
+    char *Page = BufImage(Frame);
 
     /* Find insertion position */
-    KeyListTraverser = PagePtr->KeyListPtr;
-    InsertionPosition = FindInsertionPosition(KeyListTraverser, Key, &Found,
-                                              PagePtr->NumKeys, Count);
+    KeyLen = strlen(Key);
+    InsertionPosition = SlotSearch(Page, Key, KeyLen, &Found);
 
     /* Key is already in the B-Tree */
     if (Found == TRUE) {
 
         POSTINGSPTR oldpointer;
-        /* printf ("Key = %s\n", Key);
-        printf ("  Text Offsets are:\n");  */
-        for (i = 0; i < InsertionPosition - 1; i++)
-            KeyListTraverser = KeyListTraverser->Next;
         /* change made here by Frank Andrasco
            since postings pointer may change, pointer must be passed by
            reference
            instead of by value  */
 
-        oldpointer = KeyListTraverser->Posting;
-        UpdatePostingsFile(&KeyListTraverser->Posting, TextOffset);
-        /* check to see if posting value changed, if so rewrite to disk */
-        if (KeyListTraverser->Posting == oldpointer)
-            FreePage(PagePtr);
-        else
-            FlushPage(PagePtr);
+        PostOffset = oldpointer = SlotPtr(Page, InsertionPosition);
+        UpdatePostingsFile(&PostOffset, New);
+        /* check to see if posting value changed, if so rewrite the page */
+        if (PostOffset == oldpointer)
+            BufUnpin(Frame, FALSE);
+        else {
+            SlotSetPtr(Page, InsertionPosition, PostOffset);
+            BufUnpin(Frame, TRUE);
+        }
         return (NULL);
     }
 
     /* Key must be inserted in B-Tree */
-    CreatePosting(TextOffset, &PostOffset);
+    CreatePosting(New, &PostOffset);
+
+    /* it fits: insert it in place */
+    if (SlotInsert(Page, InsertionPosition, Key, KeyLen, PostOffset)) {
+        BufUnpin(Frame, TRUE);
+        return (NULL);
+    }
+
+    /* the page overflows: build the list of keys and split it */
+    PagePtr = FetchPage(SlotPgNum(Page));
+    BufUnpin(Frame, FALSE); /* FetchPage() holds its own pin */
+
     /* Traverse the list of keys to insertion position */
     KeyListTraverser = PagePtr->KeyListPtr;
     for (i = 0; i < InsertionPosition; i++) {
@@ -75,7 +93,7 @@ struct upKey *InsertKeyInLeaf(struct PageHdr *PagePtr, char *Key,
     /* Create a new node for the new key and insert key informtion */
     NewKeyNode = (struct KeyRecord *) malloc(sizeof(*NewKeyNode));
     ck_malloc(NewKeyNode, "NewKeyNode");
-    NewKeyNode->KeyLen = strlen(Key);
+    NewKeyNode->KeyLen = KeyLen;
     NewKeyNode->StoredKey = strsave(Key);
     NewKeyNode->Posting = PostOffset;
 
@@ -90,12 +108,7 @@ struct upKey *InsertKeyInLeaf(struct PageHdr *PagePtr, char *Key,
     /* Update page header information */
     fillIn(PagePtr);
 
-    /* split page, if necessary, and flush */
-    if (PagePtr->NumBytes <= PAGESIZE) {
-        FlushPage(PagePtr);
-        return (NULL);
-    } else {
-        MiddleKey = SplitPage(PagePtr);
-        return (MiddleKey);
-    }
+    /* split page, and flush */
+    MiddleKey = SplitPage(PagePtr);
+    return (MiddleKey);
 }
@@ -3,21 +3,32 @@
 *                                                                        *
 *    This function inserts a key into a nonleaf page.  In the case       *
 *    where the nonleaf page contains zero keys (the root), the first     *
-*    key is inserted into the root and the only leaf page becomes        *
-*    the rightmost child.                                                *
-     It returns NULL, or a pointer to the key ("upKey") structure
-     to be propagated upstairs.
+*    key is inserted into the root and the only leaf page becomes the    *
+*    rightmost child.                                                    *
+*                                                                        *
+*    The page is given as the buffer-pool frame that holds it, pinned;   *
+*    the frame is released before returning.  The key is inserted in     *
+*    place, in the slot array of the page image (see slotpage.c),        *
+*    unless the page overflows and has to be split.  It returns NULL,    *
+*    or a pointer to the key ("upKey") structure to be propagated        *
+*    upstairs.                                                           *
 *                                                                        *
 *************************************************************************/
 
 #include "def.h"
 
-extern int FreePage(struct PageHdr *PagePtr);
-extern int FlushPage(struct PageHdr *PagePtr);
 extern int fillIn(struct PageHdr *PagePtr);
+extern struct PageHdr *FetchPage(PAGENO Page);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotSearch(char *Page, char *Key, int KeyLen, int *Found);
+extern int SlotInsert(char *Page, int i, char *Key, int KeyLen, long Ptr);
+extern void SlotSetPtr(char *Page, int i, long Ptr);
+extern void SlotSetLink(char *Page, PAGENO Link);
+extern int SlotNumKeys(char *Page);
+extern PAGENO SlotPgNum(char *Page);
 
-struct upKey *InsertKeyInNonLeaf(struct PageHdr *PagePtr,
-                                 struct upKey *MiddleKey)
+struct upKey *InsertKeyInNonLeaf(int Frame, struct upKey *MiddleKey)
 
 /* Key to be inserted in this non-leaf page */
 {
@@ -25,42 +36,48 @@ struct upKey *InsertKeyInNonLeaf(struct PageHdr *PagePtr,
         *KeyListTrailer,                /* Pointers to the list of keys */
         *MiddleKeyCopy;                 /* KeyRecord structure, to contain */
     /* the MiddleKey */
-    int Count, Found, InsertionPosition, i;
-    int FindInsertionPosition(struct KeyRecord * KeyListTraverser, char *Key,
-                              int *Found, NUMKEYS NumKeys, int Count);
-    char *Word; /* Key stored in B-Tree */
+    struct PageHdr *PagePtr;
+    int Found, InsertionPosition, NumKeys, i;
+    KEYLEN KeyLen;
     struct upKey *newUpKey, *SplitPage(struct PageHdr * PagePtr);
     char *strsave(char *s);
+    char *Page = BufImage(Frame);
 
-    if (MiddleKey == NULL) { /* just free the page-image */
-        FreePage(PagePtr);
+    if (MiddleKey == NULL) { /* just release the page-image */
+        BufUnpin(Frame, FALSE);
         return (NULL);
     }
 
-    /* build an appropriate KeyRecord node for the inserted key */
-    MiddleKeyCopy = (struct KeyRecord *) malloc(sizeof(struct KeyRecord));
-    MiddleKeyCopy->PgNum = MiddleKey->left;
-    MiddleKeyCopy->KeyLen = strlen(MiddleKey->key);
-    MiddleKeyCopy->StoredKey = strsave(MiddleKey->key);
+    /* Find insertion position for key */
+    KeyLen = strlen(MiddleKey->key);
+    NumKeys = SlotNumKeys(Page);
+    InsertionPosition = SlotSearch(Page, MiddleKey->key, KeyLen, &Found);
 
-    /* Root page currently has zero keys:  this key will be first insertion */
-    /* NOTE: maybe this "if" block is redundant, if "FindInsertionPosition" */
-    /*       works with a empty list!: -christos- */
-    if (PagePtr->NumKeys == 0) {
-        PagePtr->PtrToFinalRtgPg = MiddleKey->right;
-        PagePtr->KeyListPtr = MiddleKeyCopy;
-        MiddleKeyCopy->Next = NULL;
-        FlushPage(PagePtr); /* it fills in the # of bytes & # of keys */
+    /* it fits: insert it in place; the key that used to point to the
+       split page (or the rightmost pointer) now points to its right half.
+       This also covers a root page with zero keys (first insertion). */
+    if (SlotInsert(Page, InsertionPosition, MiddleKey->key, KeyLen,
+                   MiddleKey->left)) {
+        if (InsertionPosition == NumKeys) /* ie., it is last */
+            SlotSetLink(Page, MiddleKey->right);
+        else
+            SlotSetPtr(Page, InsertionPosition + 1, MiddleKey->right);
+        BufUnpin(Frame, TRUE);
+        free(MiddleKey->key);
+        free((char *) MiddleKey);
         return (NULL);
     }
 
-    /* Find insertion position for key */
-    /* -christos- : make it a procedure, say, inList() */
-    Word = MiddleKeyCopy->StoredKey;
-    Count = 0;
-    KeyListTraverser = PagePtr->KeyListPtr;
-    InsertionPosition = FindInsertionPosition(KeyListTraverser, Word, &Found,
-                                              PagePtr->NumKeys, Count);
+    /* the page overflows: build the list of keys and split it */
+    PagePtr = FetchPage(SlotPgNum(Page));
+    BufUnpin(Frame, FALSE); /* FetchPage() holds its own pin */
+
+    /* build an appropriate KeyRecord node for the inserted key */
+    MiddleKeyCopy = (struct KeyRecord *) malloc(sizeof(struct KeyRecord));
+    ck_malloc(MiddleKeyCopy, "MiddleKeyCopy");
+    MiddleKeyCopy->PgNum = MiddleKey->left;
+    MiddleKeyCopy->KeyLen = KeyLen;
+    MiddleKeyCopy->StoredKey = strsave(MiddleKey->key);
 
     /* Traverse list of keys to insertion postion */
     KeyListTraverser = PagePtr->KeyListPtr;
@@ -89,12 +106,7 @@ struct upKey *InsertKeyInNonLeaf(struct PageHdr *PagePtr,
     free(MiddleKey->key);
     free((char *) MiddleKey);
 
-    /* split, if it overflows, and flush */
-    if (PagePtr->NumBytes <= PAGESIZE) {
-        FlushPage(PagePtr);
-        return (NULL);
-    } else {
-        newUpKey = SplitPage(PagePtr);
-        return (newUpKey);
-    }
+    /* split, and flush */
+    newUpKey = SplitPage(PagePtr);
+    return (newUpKey);
 }
@@ -7,82 +7,69 @@
 ************************************************************************/
 
 #include "def.h"
-extern FILE *fpbtree;
 
-void printPage(PAGENO i, FILE *fpb);
-extern long int ffsize(FILE *fp);
+void printPage(PAGENO i);
+extern PAGENO FindNumPagesInTree(void);
+extern int BufPin(PAGENO Page, int Load);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotNumKeys(char *Page);
+extern PAGENO SlotPgNum(char *Page);
+extern PAGENO SlotLink(char *Page);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern long SlotPtr(char *Page, int i);
+extern int SlotBytes(char *Page);
 
 void PrintTree(void) {
     PAGENO i;
 
-    fpbtree = fopen("B-TREE_FILE", "r");
-
     /* print the pages of the tree */
     printf("Here is the B-Tree By Page (starting with the root):\n\n");
 
-    for (i = 1; feof(fpbtree) == 0; i++) {
-        printPage(i, fpbtree);
+    for (i = 1; i <= FindNumPagesInTree(); i++) {
+        printPage(i);
     }
-    fclose(fpbtree);
 }
 
-void printPage(PAGENO i, FILE *fpb) {
-    POSTINGSPTR PostOffset;
+void printPage(PAGENO i) {
     NUMKEYS NumKeys;
-    KEYLEN KeyLen;
-    NUMBYTES NumBytes;
-    PAGENO PtrToNxtLfPg, PtrToFinalRtgPg, PgNum;
-    int j;
-    char key[MAXWORDSIZE], Ch;
+    int j, Frame, KeyLen;
+    char *Page, *key;
 
     if (i < 1) {
         printf("page numbers start from 1 and on\n");
         return;
     }
 
-    if (ffsize(fpb) <= (i - 1) * PAGESIZE) { /* illegal page number */
+    if (i > FindNumPagesInTree()) { /* illegal page number */
         printf("page numbers start from 1 and not exceed the last one \n");
         return;
     }
 
-    fseek(fpb, (long) (i - 1) * PAGESIZE, 0);
-    fread(&Ch, sizeof(Ch), 1, fpb);
-    if (feof(fpb) != 0)
-        exit(0);
-    printf("Leafstatus:%c\n", Ch);
-    fread(&PgNum, sizeof(PgNum), 1, fpb);
-    printf("Page#:%d\n", (int) PgNum);
-    if (Ch == LeafSymbol) {
-        fread(&PtrToNxtLfPg, sizeof(PtrToNxtLfPg), 1, fpb);
-        printf("PtrtoNextLeafPage:%d\n", (int) PtrToNxtLfPg);
-    }
-    fread(&NumBytes, sizeof(NumBytes), 1, fpb);
-    printf("Number of bytes occcupied:%d\n", NumBytes);
-    fread(&NumKeys, sizeof(NumKeys), 1, fpb);
+    Frame = BufPin(i, TRUE);
+    Page = BufImage(Frame);
+    printf("Leafstatus:%c\n", Page[SP_TYPE]);
+    printf("Page#:%d\n", (int) SlotPgNum(Page));
+    if (IsLeafImage(Page))
+        printf("PtrtoNextLeafPage:%d\n", (int) SlotLink(Page));
+    printf("Number of bytes occcupied:%d\n", SlotBytes(Page));
+    NumKeys = SlotNumKeys(Page);
     printf("Number of keys:%d\n", NumKeys);
-    if (Ch == NonLeafSymbol) {
-        fread(&PtrToFinalRtgPg, sizeof(PtrToFinalRtgPg), 1, fpb);
-        printf("PtrToFinalRtgPg%d\n", (int) PtrToFinalRtgPg);
-    }
+    if (IsNonLeafImage(Page))
+        printf("PtrToFinalRtgPg%d\n", (int) SlotLink(Page));
     for (j = 0; j < NumKeys; j++) {
-        if (Ch == NonLeafSymbol) {
-            fread(&PgNum, sizeof(PgNum), 1, fpbtree);
-            printf("NextPage:%d, ", (int) PgNum);
-            fread(&KeyLen, sizeof(KeyLen), 1, fpbtree);
-            fread(key, sizeof(char), KeyLen, fpbtree);
-            (*(key + KeyLen)) = '\0';
-            printf("key:%s, ", key);
+        key = SlotKey(Page, j, &KeyLen);
+        if (IsNonLeafImage(Page)) {
+            printf("NextPage:%d, ", (int) SlotPtr(Page, j));
+            printf("key:%.*s, ", KeyLen, key);
             printf("length:%d\n", KeyLen);
         }
-        if (Ch == LeafSymbol) {
-            fread(&KeyLen, sizeof(KeyLen), 1, fpbtree);
+        if (IsLeafImage(Page)) {
             printf("Keylength:%d, ", KeyLen);
-            fread(key, sizeof(char), KeyLen, fpbtree);
-            (*(key + KeyLen)) = '\0';
-            printf("key:%s, ", key);
-            fread(&PostOffset, sizeof(PostOffset), 1, fpbtree);
-            printf("Postings offset:%d\n", (int) PostOffset);
+            printf("key:%.*s, ", KeyLen, key);
+            printf("Postings offset:%d\n", (int) SlotPtr(Page, j));
         }
     }
     printf("\n");
+    BufUnpin(Frame, FALSE);
 }
@@ -1,20 +1,23 @@
 /**********************************************************************
 *                                                                     *
-*     This recursive function traverses through the B-Tree on a       *
+*     This function inserts a key in the B-Tree.  It finds the        *
 *     directed path (beginning at the root and traversing down to     *
-*     the leaf page that contains, or should contain the new key.     *
-*     As pages are split, the middle keys are propagated up to the    *
-*     parent pages for insertion.  In the case where the root has     *
-*     been split, the function returns the middle key which is to     *
-*     be inserted in the new root, in the form of an "upKey" structure
-      The function returns NULL otherwise.
+*     the leaf page that contains, or should contain the new key)     *
+*     with TreeDescend(), inserts the key in the leaf, and then       *
+*     climbs back up the path: as pages are split, the middle keys    *
+*     are propagated up to the parent pages for insertion.  In the    *
+*     case where the root has been split, the function returns the    *
+*     middle key which is to be inserted in the new root, in the      *
+*     form of an "upKey" structure.  The function returns NULL        *
+*     otherwise.                                                      *
 *                                                                     *
-*     Note that the variable NewKey points to a possible              *
-*     propagated-up middle key and that key is sent to the function   *
-*     InsertKey, which may, in turn, return a possible new            *
-*     middle key which must be propagated-up to the parent page       *
-*     for insertion.  In the abstract, NewKey travels down the        *
-*     tree and MiddleKey travels upward.                              *
+*     The pages are searched in place, in their buffer-pool frames;   *
+*     InsertKeyInLeaf and InsertKeyInNonLeaf release the frames.      *
+*                                                                     *
+*     Note that the variable MiddleKey holds a possible middle key    *
+*     which is sent to the function InsertKeyInNonLeaf, which may,    *
+*     in turn, return a possible new middle key which must be         *
+*     propagated-up to the next page of the path for insertion.       *
 *                                                                     *
 *     This function may be considered the core of the B-Tree          *
 *     program.                                                        *
@@ -23,33 +26,25 @@
 
 #include "def.h"
 
+extern char *PinPage(PAGENO Page, int *pFrame);
+extern char *TreeDescend(PAGENO Root, char *Key, struct TreePath *Path);
+
 struct upKey *PropagatedInsertion(PAGENO PageNo, char *Key,
-                                  TEXTPTR TextOffset) {
-    PAGENO ChildPage, FindPageNumOfChild(struct PageHdr * PagePtr,
-                                         struct KeyRecord * KeyListTraverser,
-                                         char *Key, NUMKEYS NumKeys);
-    struct upKey *NewKey, *MiddleKey;
-    struct upKey *InsertKeyInLeaf(struct PageHdr * PagePtr, char *Key,
-                                  TEXTPTR TextOffset),
-        *InsertKeyInNonLeaf(struct PageHdr * PagePtr, struct upKey * MiddleKey);
-    struct KeyRecord *KeyListTraverser; /* Pointer to list of keys */
-    struct PageHdr *PagePtr;
-    struct PageHdr *FetchPage(PAGENO Page);
+                                  struct PostBatch *New) {
+    struct upKey *MiddleKey;
+    struct upKey *InsertKeyInLeaf(int Frame, char *Key,
+                                  struct PostBatch *New),
+        *InsertKeyInNonLeaf(int Frame, struct upKey *MiddleKey);
+    struct TreePath Path; /* from page PageNo down to the leaf */
+    int Frame, d;
 
-    PagePtr = FetchPage(PageNo);
+    /* the leaf comes back pinned */
+    TreeDescend(PageNo, Key, &Path);
+    MiddleKey = InsertKeyInLeaf(Path.Frame, Key, New);
 
-    if (IsLeaf(PagePtr)) {
-        MiddleKey = InsertKeyInLeaf(PagePtr, Key, TextOffset);
-    } else if (IsNonLeaf(PagePtr)) {
-        KeyListTraverser = PagePtr->KeyListPtr;
-        ChildPage = FindPageNumOfChild(PagePtr, KeyListTraverser, Key,
-                                       PagePtr->NumKeys);
-        NewKey = PropagatedInsertion(ChildPage, Key, TextOffset);
-        MiddleKey = InsertKeyInNonLeaf(PagePtr, NewKey);
-    } else { /* impossible */
-        printf("Prop-Insertion: Illegal PageType:%c", PagePtr->PgTypeID);
-        printf("in page# %d - aborting\n", (int) PagePtr->PgNum);
-        exit(-2);
+    for (d = Path.Depth - 2; (d >= 0) && (MiddleKey != NULL); d--) {
+        PinPage(Path.PgNum[d], &Frame);
+        MiddleKey = InsertKeyInNonLeaf(Frame, MiddleKey);
     }
 
     return (MiddleKey);
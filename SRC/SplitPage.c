@@ -3,19 +3,23 @@
 *                                                                          *
 *    This function splits leaf and nonleaf pages.  The page is split       *
 *    according to the number of keys it contains.  Half remain in the      *
-*    current page (half + one in the case where the total number of        *
-*    keys is an odd number), and half are transferred to a newly created   *
-*    page.  The two pages are written to disk (FlushPage()).  The          *
-*    function returns the middle key which is to be inserted in the        *
-*    parent page,                                                          *
-     in an "upKey" structure
-
+*    current page (half + one in the case where the total number of keys   *
+*    is an odd number), and half are transferred to a newly created page.  *
+*    The two pages are written to disk (FlushPage()).  The function        *
+*    returns the middle key which is to be inserted in the parent page,    *
+*    in an "upKey" structure.                                              *
+*                                                                          *
+*    When a leaf splits, the key pushed up is the shortest string that     *
+*    separates the two halves (KeySeparator(), see keycmp.c), rather than  *
+*    the whole middle key.                                                 *
 *                                                                          *
 ***************************************************************************/
 
 #include "def.h"
 
 extern int FlushPage(struct PageHdr *PagePtr);
+extern int KeySeparator(char *Left, int LeftLen, char *Right, int RightLen,
+                        char *Sep);
 
 struct upKey *SplitPage(struct PageHdr *PagePtr) {
     int i;
@@ -31,6 +35,7 @@ struct upKey *SplitPage(struct PageHdr *PagePtr) {
 
     struct upKey *upk; /* structure with middle key, */
                        /* to be returned upwards */
+    char sep[MAXWORDSIZE + 1];
 
     /* Determine the number of keys to remain in current page and
        the number to be transferred to new page                */
@@ -45,6 +50,8 @@ struct upKey *SplitPage(struct PageHdr *PagePtr) {
         pbefore = pbefore->Next;
     }
     pmiddle = pbefore->Next;
+    if (IsLeaf(PagePtr) && (FirstHalfNumKeys == 1))
+        pmiddle = pbefore; /* a leaf of 2 keys splits 1/1 */
     pafter = pmiddle->Next;
 
     /* Install the header of new page */
@@ -52,6 +59,7 @@ struct upKey *SplitPage(struct PageHdr *PagePtr) {
     ck_malloc(newPagePtr, "newPagePtr");
     newPagePtr->PgTypeID = PagePtr->PgTypeID;
     newPagePtr->PgNum = getNewPageNum();
+    newPagePtr->PinnedFrame = NOFRAME;
     if (IsLeaf(newPagePtr))
         newPagePtr->PgNumOfNxtLfPg = PagePtr->PgNumOfNxtLfPg;
     if (IsNonLeaf(newPagePtr))
@@ -77,7 +85,12 @@ struct upKey *SplitPage(struct PageHdr *PagePtr) {
     ck_malloc(upk, "upk");
     upk->left = PagePtr->PgNum;
     upk->right = newPagePtr->PgNum;
-    upk->key = strsave(pmiddle->StoredKey);
+    if (IsLeaf(PagePtr)) { /* any key between the halves will do */
+        KeySeparator(pmiddle->StoredKey, pmiddle->KeyLen, pafter->StoredKey,
+                     pafter->KeyLen, sep);
+        upk->key = strsave(sep);
+    } else
+        upk->key = strsave(pmiddle->StoredKey);
     /* -christos-: modify this portion, with "struct upKey" -DONE! */
 
     FlushPage(PagePtr);
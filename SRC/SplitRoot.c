@@ -3,9 +3,10 @@
 *    Prior to execution of this function, the Root has already been     *
 *    split by the function SplitPage().  The current Root contains      *
 *    the left half of the Root that was split.  This function creates   *
-*    a new root (still located as the first page on disk) and installs  *
-*    the key that has propagated up to the Root.  The current root is   *
-*    installed as the left child of the new Root.                       *
+*    a new root (still at the root page named in the superblock) and    *
+*    installs the key that has propagated up to the Root.  The current  *
+*    root is installed as the left child of the new Root, and the tree  *
+*    height in the superblock grows by one.                             *
 *                                                                       *
 ************************************************************************/
 
@@ -38,6 +39,7 @@ void SplitRoot(PAGENO RootPageNum, struct upKey *upKeyPtr) {
     ck_malloc(NewPagePtr, "NewPagePtr");
     NewPagePtr->PgTypeID = NonLeafSymbol;
     NewPagePtr->PgNum = ROOT;
+    NewPagePtr->PinnedFrame = NOFRAME;
     NewPagePtr->PtrToFinalRtgPg = upKeyPtr->right;
     /* points to the second half of old root */
 
@@ -56,4 +58,5 @@ void SplitRoot(PAGENO RootPageNum, struct upKey *upKeyPtr) {
 
     FlushPage(NewPagePtr);
     FlushPage(PagePtr);
+    SuperBlk.Height++;
 }
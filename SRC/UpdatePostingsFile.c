@@ -1,17 +1,25 @@
 /* UpdatePostingsFile.c */
 /*  The function UpdatePostingsFile is passed two values:
-    a pointer to an offset in the postings file, and a offset value
-    referring to the textfile.  The routines get the record at the
+    a pointer to an offset in the postings file, and a batch of new
+    postings: document numbers (see doctable.c), each with the term
+    frequency of the word in that document, and its positions there
+    (with POSITIONS only).  The routines get the record at the
     postings file offset and checks to see if there is enough space for
-    another text offset.  If there is empty offset space available in the
-    same record, the number of text offsets in the record is incremented
-    and re-written to the record and the new text offset is added to the end
-    of the record.
+    the new documents.  If there is empty space available in the
+    same record, the number of documents in the record is incremented
+    and re-written to the record and the new documents are added to
+    the end of the record.
 
-    If the current postings list is full, all the pointers are read into
-    memory, and the current record is added to a freelist of that size
-    record.  A freelist of every size record is kept by keeping the head
-    pointers in the first record of the file.
+    The documents are delta-coded (see postrec.c): the record is read,
+    and the new documents are added to its tail (PostAppend()), each as its
+    difference with the one before, followed by its frequency (and its
+    positions); the rest of the record is not decoded.  However many
+    postings the batch has, the record is read once, and written once,
+    in place or moved once.
+
+    If the current postings list is full, the current record is added to
+    a freelist of that size record.  A freelist of every size record is
+    kept by keeping the head pointers in the first record of the file.
 
     A new free record of the next largest size, if available, is retrieved
     from the appropriate head pointer at the beginning of the file.  If there
@@ -22,60 +30,57 @@
 #include <stdio.h>
 #include "def.h"
 
-extern int pWriteCount, pReadCount;
+extern int pWriteCount;
 extern FILE *fppost;
 
-extern int isfull(int count);
+extern int isfull(long Used, int Extra);
 extern void freerec(POSTINGSPTR pptr, long int size);
 extern POSTINGSPTR getrec(long int size);
+extern long PostAppend(unsigned char *Buf, struct PostHdr *Hdr, DOCID Doc,
+                       POSTCOUNT Tf, POSTCOUNT *Where);
+extern unsigned char *PostRead(POSTINGSPTR pptr, struct PostHdr *Hdr);
+extern void PostWrite(POSTINGSPTR pptr, struct PostHdr *Hdr,
+                      unsigned char *Buf, long Len);
 
-void UpdatePostingsFile(POSTINGSPTR *pPostOffset, TEXTPTR NewTextOffset) {
-    TEXTPTR TextOffset;
-    NUMPTRS NumTextOffsets;
+void UpdatePostingsFile(POSTINGSPTR *pPostOffset, struct PostBatch *New) {
+    struct PostHdr hdr;
+    unsigned char *TPtrList;
+    POSTCOUNT *where = New->Where;
+    long OldBytes, changed, off, npos = 0;
+    NUMPTRS i;
 
-    /* goto postings offset */
-    fseek(fppost, (long) *pPostOffset, 0);
-    /* read in the number of postings pointers */
-    fread(&NumTextOffsets, sizeof(NumTextOffsets), 1, fppost);
+    /* read in the record, and add the new documents in memory */
+    TPtrList = PostRead(*pPostOffset, &hdr);
+    OldBytes = hdr.NumBytes;
+    for (i = 0; POSITIONS && (i < New->Num); i++)
+        npos += New->Tfs[i];
+    TPtrList = (unsigned char *) realloc(
+        TPtrList, OldBytes + POSTSLACK + PostBytes(New->Num, npos));
+    ck_malloc(TPtrList, "TPtrList");
+    for (changed = OldBytes, i = 0; i < New->Num; i++) {
+        off = PostAppend(TPtrList, &hdr, New->Docs[i], New->Tfs[i], where);
+        changed = min(changed, off);
+        if (POSITIONS)
+            where += New->Tfs[i];
+    }
 
-    /* check if there is space available for another pointer */
-    if (!isfull(NumTextOffsets)) {
-        /* update number of pointers */
-        NumTextOffsets++;
-        fseek(fppost, (long) *pPostOffset, 0);
+    /* check if there is space available for the new bytes */
+    if (!isfull(OldBytes, hdr.NumBytes - OldBytes)) {
+        /* rewrite what changed, and update number of pointers */
         pWriteCount++;
-
-        fwrite(&NumTextOffsets, sizeof(NumTextOffsets), 1, fppost);
-        /* read past all old text pointers */
-        fseek(fppost, (long) sizeof(NewTextOffset) * (NumTextOffsets - 1), 1);
-        /* write new text pointer */
-        fwrite(&NewTextOffset, sizeof(NewTextOffset), 1, fppost);
+        fseek(fppost, (long) (*pPostOffset + POSTHDRSIZE + changed), 0);
+        fwrite(TPtrList + changed, 1, hdr.NumBytes - changed, fppost);
+        PostWrite(*pPostOffset, &hdr, NULL, 0);
     } else /* we need to create a new postings record and free old */
     {
-        TEXTPTR *TPtrList;
-        /* get space to hold list of text pointers */
-        TPtrList = (TEXTPTR *) malloc(sizeof(TEXTPTR) * NumTextOffsets);
-        ck_malloc(TPtrList, "Textpointer List");
-        pReadCount++;
-        /* save position in record */
-        ftell(fppost);
-        /* read in list of text pointers */
-        fread(TPtrList, sizeof(TextOffset), NumTextOffsets, fppost);
-
-        /* add the current text pointer record to one of the free lists */
-        freerec(*pPostOffset, NumTextOffsets);
+        /* add the current postings record to one of the free lists */
+        freerec(*pPostOffset, OldBytes);
 
         /* get new block of next larger size */
-        NumTextOffsets++;
-        *pPostOffset = getrec(NumTextOffsets);
-
-        /* goto the new block on the disk */
-        pWriteCount++;
-        fseek(fppost, (long) *pPostOffset, 0);
+        *pPostOffset = getrec(hdr.NumBytes);
 
         /* write new list of pointers */
-        fwrite(&NumTextOffsets, sizeof(NumTextOffsets), 1, fppost);
-        fwrite(TPtrList, sizeof(TextOffset), NumTextOffsets - 1, fppost);
-        fwrite(&NewTextOffset, sizeof(TextOffset), 1, fppost);
+        PostWrite(*pPostOffset, &hdr, TPtrList, hdr.NumBytes);
     }
+    free(TPtrList);
 }
@@ -0,0 +1,168 @@
+/* accum.c */
+
+/*  Collects the postings of the documents inserted one after the other
+    (commands "i"), so that each word gets its new postings all at once
+    (InsertTree(), with a PostBatch): its postings record is read once,
+    and written, or moved to a larger one, once, for the whole batch,
+    instead of once per document.
+
+    AccAdd() adds one (word, document) pair, with its term frequency
+    (and positions).  The pairs of a word are kept together, in the
+    order they came, so by increasing document; the words are kept in
+    a chained hash table, and in the order they first came.  AccFlush()
+    inserts the words in that order, so the tree gets its keys in the
+    same order, and has the same shape, as with one insertion per
+    pair, and empties the accumulator.
+
+    The accumulator holds BATCHMEM kilobytes at most (see setparms.c):
+    AccAdd() flushes it when it gets fuller.  The caller flushes it at
+    the end of the batch - before any command but "i", and before the
+    database is closed.  Until then, the new documents are in TEXTFILE,
+    but not in the index.
+*/
+
+#include "def.h"
+
+#define ACCMINSIZE (1024) /* buckets of the hash table, at first */
+
+struct AccWord {
+    char *Word;
+    NUMPTRS Num, Max; /* postings, and room for them */
+    DOCID *Docs;
+    POSTCOUNT *Tfs;
+    POSTCOUNT *Where; /* the positions, with POSITIONS */
+    long NumWhere, MaxWhere;
+    struct AccWord *Next; /* in its chain of the hash table */
+};
+
+extern void InsertTree(char *Key, struct PostBatch *New);
+
+static struct AccWord **Table = NULL; /* the hash table */
+static long TableSize;
+static struct AccWord **Order = NULL; /* the words, as they first came */
+static long NumWords, MaxWords;
+static long Used; /* bytes held */
+
+static unsigned long AccHash(char *Word) {
+    unsigned long h = 5381;
+
+    while (*Word != EOS)
+        h = h * 33 + (unsigned char) *Word++;
+    return (h);
+}
+
+/* doubles the hash table (or makes it), and rehashes the words */
+static void AccGrow(void) {
+    long i, size = (Table == NULL) ? ACCMINSIZE : 2 * TableSize;
+    struct AccWord *w;
+
+    Used += sizeof(struct AccWord *) * ((Table == NULL) ? size : TableSize);
+    free(Table);
+    Table = (struct AccWord **) calloc(size, sizeof(struct AccWord *));
+    ck_malloc(Table, "Table in AccGrow()");
+    TableSize = size;
+    for (i = 0; i < NumWords; i++) {
+        w = Order[i];
+        w->Next = Table[AccHash(w->Word) & (TableSize - 1)];
+        Table[AccHash(w->Word) & (TableSize - 1)] = w;
+    }
+}
+
+/* the entry of 'Word', made if it is new */
+static struct AccWord *AccFind(char *Word) {
+    struct AccWord *w;
+    unsigned long h;
+
+    if ((Table == NULL) || (NumWords >= TableSize))
+        AccGrow();
+    h = AccHash(Word) & (TableSize - 1);
+    for (w = Table[h]; w != NULL; w = w->Next)
+        if (strcmp(w->Word, Word) == 0)
+            return (w);
+
+    w = (struct AccWord *) malloc(sizeof(struct AccWord));
+    ck_malloc(w, "w in AccFind()");
+    w->Word = malloc(strlen(Word) + 1);
+    ck_malloc(w->Word, "w->Word in AccFind()");
+    strcpy(w->Word, Word);
+    w->Num = w->Max = 0;
+    w->Docs = NULL;
+    w->Tfs = NULL;
+    w->Where = NULL;
+    w->NumWhere = w->MaxWhere = 0;
+    w->Next = Table[h];
+    Table[h] = w;
+    if (NumWords == MaxWords) {
+        MaxWords = max(2 * MaxWords, ACCMINSIZE);
+        Order = (struct AccWord **) realloc(
+            Order, sizeof(struct AccWord *) * MaxWords);
+        ck_malloc(Order, "Order in AccFind()");
+    }
+    Order[NumWords++] = w;
+    Used += sizeof(struct AccWord) + strlen(Word) + 1 +
+            sizeof(struct AccWord *);
+    return (w);
+}
+
+/* inserts the words collected so far, in the order they first came,
+   each with all its new postings, and empties the accumulator */
+void AccFlush(void) {
+    struct PostBatch batch;
+    struct AccWord *w;
+    long i;
+
+    for (i = 0; i < NumWords; i++) {
+        w = Order[i];
+        batch.Num = w->Num;
+        batch.Docs = w->Docs;
+        batch.Tfs = w->Tfs;
+        batch.Where = w->Where;
+        InsertTree(w->Word, &batch);
+        free(w->Word);
+        free(w->Docs);
+        free(w->Tfs);
+        free(w->Where);
+        free(w);
+    }
+    free(Table);
+    free(Order);
+    Table = NULL;
+    Order = NULL;
+    NumWords = MaxWords = 0;
+    Used = 0;
+}
+
+/* adds the document 'Doc' to the new postings of 'Word', where it occurs
+   'Tf' times, at the positions 'Where' (with POSITIONS); the documents
+   of a word must come in increasing order */
+void AccAdd(char *Word, DOCID Doc, POSTCOUNT Tf, POSTCOUNT *Where) {
+    struct AccWord *w = AccFind(Word);
+    long n;
+
+    assert((w->Num == 0) || (Doc > w->Docs[w->Num - 1]));
+    if (w->Num == w->Max) {
+        n = max(2 * w->Max, 4);
+        w->Docs = (DOCID *) realloc(w->Docs, sizeof(DOCID) * n);
+        w->Tfs = (POSTCOUNT *) realloc(w->Tfs, sizeof(POSTCOUNT) * n);
+        ck_malloc(w->Docs, "w->Docs in AccAdd()");
+        ck_malloc(w->Tfs, "w->Tfs in AccAdd()");
+        Used += (sizeof(DOCID) + sizeof(POSTCOUNT)) * (n - w->Max);
+        w->Max = n;
+    }
+    w->Docs[w->Num] = Doc;
+    w->Tfs[w->Num++] = Tf;
+    if (POSITIONS) {
+        if (w->NumWhere + Tf > w->MaxWhere) {
+            n = max(2 * w->MaxWhere, w->NumWhere + Tf);
+            w->Where = (POSTCOUNT *) realloc(w->Where,
+                                             sizeof(POSTCOUNT) * n);
+            ck_malloc(w->Where, "w->Where in AccAdd()");
+            Used += sizeof(POSTCOUNT) * (n - w->MaxWhere);
+            w->MaxWhere = n;
+        }
+        memcpy(w->Where + w->NumWhere, Where, sizeof(POSTCOUNT) * Tf);
+        w->NumWhere += Tf;
+    }
+    if (Used > (long) BATCHMEM * 1024)
+        AccFlush();
+}
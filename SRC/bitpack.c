@@ -0,0 +1,187 @@
+/* bitpack.c */
+
+/*  Bit packing of blocks of BLOCKSIZE (128) values of up to 32 bits,
+    for the blocks of postings records (see postrec.c).
+
+    A block packed with 'Bits' bits per value takes 16 * Bits bytes, as
+    4 * Bits 32-bit words.  The values are dealt to 4 lanes, value i to
+    lane i % 4, and each lane is packed into Bits words, lowest bits
+    first; the words of the lanes are interleaved, word k of lane l
+    being word 4 * k + l of the block.  So the 4 values 4j .. 4j + 3
+    sit at the same bit offset of 4 consecutive words, and one 128-bit
+    shift extracts all of them.
+
+    BitUnpack() points to the fastest decoder this CPU can run - AVX2,
+    SSE2 or plain C - chosen by CPU detection at its first call; the
+    vector decoders are compiled for their instruction set with
+    function attributes, so the program still runs on any x86 CPU, and
+    on other machines only the plain C decoder is built.
+
+    To stay branch-free, the decoders read the next row of words too,
+    so up to BITPACKSLACK bytes past the end of a block must be
+    readable.
+*/
+
+#include "def.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITPACK_X86
+#include <immintrin.h>
+#endif
+
+#define LaneWord(In, k) ((In) + 4 * (k)) /* 32-bit word k of a block */
+
+static unsigned int Word(unsigned char *In, int k) {
+    unsigned int w;
+
+    memcpy(&w, LaneWord(In, k), sizeof(w));
+    return (w);
+}
+
+static unsigned int Mask(int Bits) {
+    return ((Bits == 32) ? 0xffffffffU : (1U << Bits) - 1);
+}
+
+/* the number of bits needed for the largest of the BLOCKSIZE values */
+int BitWidth(unsigned int *In) {
+    unsigned int all = 0;
+    int i, bits;
+
+    for (i = 0; i < BLOCKSIZE; i++)
+        all |= In[i];
+    for (bits = 0; all != 0; bits++)
+        all >>= 1;
+    return (bits);
+}
+
+/* packs the BLOCKSIZE values of 'In' with 'Bits' bits each into 'Out',
+   which gets 16 * Bits bytes */
+void BitPack(unsigned int *In, int Bits, unsigned char *Out) {
+    unsigned int w;
+    int i, lane, bit, k, s;
+
+    if (Bits == 0) /* all zeros: nothing to store */
+        return;
+    memset(Out, 0, 16 * Bits);
+    for (i = 0; i < BLOCKSIZE; i++) {
+        lane = i % 4;
+        bit = (i / 4) * Bits;
+        k = 4 * (bit / 32) + lane;
+        s = bit % 32;
+        w = Word(Out, k) | (In[i] << s);
+        memcpy(LaneWord(Out, k), &w, sizeof(w));
+        if (s + Bits > 32) { /* the value runs into the next word */
+            w = Word(Out, k + 4) | (In[i] >> (32 - s));
+            memcpy(LaneWord(Out, k + 4), &w, sizeof(w));
+        }
+    }
+}
+
+/* the plain C decoder */
+static void UnpackScalar(unsigned char *In, int Bits, unsigned int *Out) {
+    unsigned int mask = Mask(Bits), v;
+    int i, bit, k, s;
+
+    for (i = 0; i < BLOCKSIZE; i++) {
+        bit = (i / 4) * Bits;
+        k = 4 * (bit / 32) + i % 4;
+        s = bit % 32;
+        v = Word(In, k) >> s;
+        if (s + Bits > 32)
+            v |= Word(In, k + 4) << (32 - s);
+        Out[i] = v & mask;
+    }
+}
+
+#ifdef BITPACK_X86
+
+/* 4 values at a time.  A shift by 32 bits or more gives 0, so the
+   words of the next row can always be or-ed in. */
+__attribute__((target("sse2"))) static void
+UnpackSSE2(unsigned char *In, int Bits, unsigned int *Out) {
+    __m128i mask = _mm_set1_epi32((int) Mask(Bits)), cur, next;
+    int j, bit, s;
+
+    for (j = 0; j < BLOCKSIZE / 4; j++) {
+        bit = j * Bits;
+        s = bit % 32;
+        cur = _mm_loadu_si128((__m128i *) (In + 16 * (bit / 32)));
+        next = _mm_loadu_si128((__m128i *) (In + 16 * (bit / 32 + 1)));
+        cur = _mm_or_si128(_mm_srl_epi32(cur, _mm_cvtsi32_si128(s)),
+                           _mm_sll_epi32(next, _mm_cvtsi32_si128(32 - s)));
+        _mm_storeu_si128((__m128i *) (Out + 4 * j), _mm_and_si128(cur, mask));
+    }
+}
+
+/* 8 values at a time: the two halves of the vector hold the rows of
+   values 4j .. 4j + 3 and 4j + 4 .. 4j + 7, with their own shifts */
+__attribute__((target("avx2"))) static void
+UnpackAVX2(unsigned char *In, int Bits, unsigned int *Out) {
+    __m256i mask = _mm256_set1_epi32((int) Mask(Bits)), cur, next, sr, sl;
+    int j, b0, b1, s0, s1;
+
+    for (j = 0; j < BLOCKSIZE / 4; j += 2) {
+        b0 = j * Bits;
+        b1 = b0 + Bits;
+        s0 = b0 % 32;
+        s1 = b1 % 32;
+        cur = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(
+                _mm_loadu_si128((__m128i *) (In + 16 * (b0 / 32)))),
+            _mm_loadu_si128((__m128i *) (In + 16 * (b1 / 32))), 1);
+        next = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(
+                _mm_loadu_si128((__m128i *) (In + 16 * (b0 / 32 + 1)))),
+            _mm_loadu_si128((__m128i *) (In + 16 * (b1 / 32 + 1))), 1);
+        sr = _mm256_setr_epi32(s0, s0, s0, s0, s1, s1, s1, s1);
+        sl = _mm256_sub_epi32(_mm256_set1_epi32(32), sr);
+        cur = _mm256_or_si256(_mm256_srlv_epi32(cur, sr),
+                              _mm256_sllv_epi32(next, sl));
+        _mm256_storeu_si256((__m256i *) (Out + 4 * j),
+                            _mm256_and_si256(cur, mask));
+    }
+}
+
+#endif
+
+static void UnpackFirst(unsigned char *In, int Bits, unsigned int *Out);
+
+/* unpacks a block of BLOCKSIZE values of 'Bits' bits from 'In' */
+void (*BitUnpack)(unsigned char *In, int Bits, unsigned int *Out) =
+    UnpackFirst;
+char *BitUnpackName = "scalar"; /* the decoder in use */
+
+/* makes BitUnpack() the decoder 'Name': "avx2", "sse2", "scalar", or
+   "best" for the fastest one this CPU runs.  Returns FALSE, leaving
+   the decoder as it is, if the CPU cannot run it. */
+int BitUnpackUse(char *Name) {
+    int best = (strcmp(Name, "best") == 0);
+
+#ifdef BITPACK_X86
+    __builtin_cpu_init();
+    if ((best || (strcmp(Name, "avx2") == 0)) &&
+        __builtin_cpu_supports("avx2")) {
+        BitUnpack = UnpackAVX2;
+        BitUnpackName = "avx2";
+        return (TRUE);
+    }
+    if ((best || (strcmp(Name, "sse2") == 0)) &&
+        __builtin_cpu_supports("sse2")) {
+        BitUnpack = UnpackSSE2;
+        BitUnpackName = "sse2";
+        return (TRUE);
+    }
+#endif
+    if (best || (strcmp(Name, "scalar") == 0)) {
+        BitUnpack = UnpackScalar;
+        BitUnpackName = "scalar";
+        return (TRUE);
+    }
+    return (FALSE);
+}
+
+/* the first call picks the decoder */
+static void UnpackFirst(unsigned char *In, int Bits, unsigned int *Out) {
+    BitUnpackUse("best");
+    BitUnpack(In, Bits, Out);
+}
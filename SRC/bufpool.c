@@ -0,0 +1,344 @@
+/* bufpool.c */
+
+/*  A fixed-size pool of page images kept in front of the B-tree file.
+
+    Every page access goes through BufPin(), which returns the number of
+    the frame holding the requested page, reading it from disk only on a
+    miss.  A pinned frame is never evicted; BufUnpin() releases it and
+    records whether the caller modified the image.  Dirty frames are
+    written back when they are chosen as victims, or when the pool is
+    flushed by BufFlushAll() (by dbsync(), at the end of every command,
+    and at dbclose()).
+
+    Write-back is batched: BufFlushAll() sorts the dirty frames by page
+    number, and a dirty victim takes along the dirty frames of the pages
+    next to it.  Runs of consecutive pages (up to MAXRUN of them) go out
+    with a single fwrite().
+
+    Victims are chosen with the CLOCK (second chance) policy: the hand
+    sweeps over the frames, clearing the reference bit of recently used
+    frames and stopping at the first unpinned frame whose bit is clear.
+
+    Frames are found by page number through a hash table with separate
+    chaining; the chains are threaded through the frames themselves.
+
+    The number of frames is POOLSIZE (see setparms.c and "parms").
+
+    If MMAPMODE is set (parameter "mmap" in "parms"), there are no frames
+    at all: the whole B-tree file is mapped into memory with mmap(), the
+    frame number of a page is the page number itself, and its image is
+    found by pointer arithmetic.  Pins and dirty bits are not needed -
+    the kernel writes back the modified pages, and the page cache is
+    shared with any other process that maps or reads the file.  The file
+    is extended in chunks of MAPCHUNK pages (or half its size, if that
+    is more); the mapping covers twice the size of the file, so that
+    it has to be remapped only once in a while.  The superblock (page
+    "0", see superblock.c) is mapped too but is not accessed this way.
+    Remapping moves the images, so callers must not hold an image
+    pointer across the allocation of a new page; they ask BufImage()
+    again instead.
+    At BufClose() the file is cut back to the pages actually used.
+*/
+
+#include "def.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define MAPCHUNK (1024) /* MMAPMODE: pages added to the file at a time */
+#define MAXRUN (64)     /* most pages written back by one fwrite() */
+
+extern FILE *fpbtree;
+extern int bufHitCount, bufMissCount, bufEvictCount; /* see stats.c */
+extern int bufWriteCount, bufPagesWritten;
+
+struct BufFrame {
+    PAGENO PgNum;  /* page held in this frame, NULLPAGENO if empty */
+    int PinCount;  /* number of users currently holding the frame */
+    int Dirty;     /* TRUE if the image differs from the disk copy */
+    int RefBit;    /* CLOCK: referenced since the hand last passed */
+    int HashNext;  /* next frame in the same hash chain, or NOFRAME */
+    char *Image;   /* PAGESIZE bytes */
+};
+
+static struct BufFrame *Frames = NULL;
+static int *BufHash = NULL; /* heads of the hash chains */
+static int HashSize;
+static int ClockHand;
+static char *RunBuf = NULL;    /* MAXRUN images, to write a run at once */
+static int *DirtyList = NULL;  /* dirty frames, sorted by BufFlushAll() */
+
+static char *MapBase = NULL; /* MMAPMODE: the mapping of the B-tree file */
+static PAGENO MapPages;      /* MMAPMODE: pages covered by the mapping */
+static PAGENO FilePages;     /* MMAPMODE: pages the file was extended to */
+/* (both not counting the superblock) */
+
+extern long ffsize(FILE *fp);
+
+/* returns the frame holding page 'Page', or NOFRAME */
+static int BufLookup(PAGENO Page) {
+    int f;
+
+    for (f = BufHash[Page % HashSize]; f != NOFRAME; f = Frames[f].HashNext)
+        if (Frames[f].PgNum == Page)
+            break;
+    return (f);
+}
+
+/* writes back the 'n' frames Run[0..n-1], which hold consecutive
+   pages, with a single fwrite() */
+static void BufWriteRun(int *Run, int n) {
+    char *src;
+    int i;
+
+    if (n == 1)
+        src = Frames[Run[0]].Image;
+    else {
+        for (i = 0; i < n; i++)
+            memcpy(RunBuf + (long) i * PAGESIZE, Frames[Run[i]].Image,
+                   PAGESIZE);
+        src = RunBuf;
+    }
+    fseek(fpbtree, (long) Frames[Run[0]].PgNum * PAGESIZE, 0);
+    if (fwrite(src, PAGESIZE, n, fpbtree) != n) {
+        printf("BufWriteRun: cannot write pages %d..%d\n",
+               (int) Frames[Run[0]].PgNum, (int) Frames[Run[0]].PgNum + n - 1);
+        exit(-2);
+    }
+    for (i = 0; i < n; i++)
+        Frames[Run[i]].Dirty = FALSE;
+    bufWriteCount++;
+    bufPagesWritten += n;
+}
+
+/* TRUE if frame 'f' can join a run written back on eviction */
+#define RunMember(f) \
+    (((f) != NOFRAME) && Frames[f].Dirty && (Frames[f].PinCount == 0))
+
+/* writes back the dirty frame 'f', together with the dirty (unpinned)
+   frames that hold the pages right before and after its page */
+static void BufWriteAround(int f) {
+    int Run[MAXRUN], n;
+    PAGENO first, page;
+
+    first = Frames[f].PgNum;
+    while ((Frames[f].PgNum - first + 1 < MAXRUN) &&
+           RunMember(BufLookup(first - 1)))
+        first--;
+    for (n = 0, page = first; n < MAXRUN; n++, page++) {
+        Run[n] = (page == Frames[f].PgNum) ? f : BufLookup(page);
+        if ((Run[n] != f) && !RunMember(Run[n]))
+            break;
+    }
+    BufWriteRun(Run, n);
+}
+
+/* removes frame 'f' from the hash chain of the page it holds */
+static void BufUnhash(int f) {
+    int *link;
+
+    link = &BufHash[Frames[f].PgNum % HashSize];
+    while (*link != f)
+        link = &Frames[*link].HashNext;
+    *link = Frames[f].HashNext;
+}
+
+/* returns an unpinned frame, writing back its old page if needed */
+static int BufVictim(void) {
+    int f, sweeps;
+
+    for (sweeps = 0; sweeps < 2 * POOLSIZE; sweeps++) {
+        f = ClockHand;
+        ClockHand = (ClockHand + 1) % POOLSIZE;
+        if (Frames[f].PinCount > 0)
+            continue;
+        if (Frames[f].RefBit) { /* second chance */
+            Frames[f].RefBit = FALSE;
+            continue;
+        }
+        if (Frames[f].PgNum != NULLPAGENO) {
+            if (Frames[f].Dirty)
+                BufWriteAround(f);
+            BufUnhash(f);
+            bufEvictCount++;
+        }
+        return (f);
+    }
+
+    printf("BufVictim: all %d frames are pinned", POOLSIZE);
+    printf(" - increase poolsize in parms\n");
+    exit(-2);
+}
+
+/* maps the superblock and the first MapPages pages of the B-tree file */
+static void BufMap(void) {
+    MapBase = mmap(NULL, (size_t) (MapPages + 1) * PAGESIZE,
+                   PROT_READ | PROT_WRITE, MAP_SHARED, fileno(fpbtree), 0);
+    if (MapBase == MAP_FAILED) {
+        perror("BufMap: mmap of B-TREE_FILE");
+        exit(-1);
+    }
+}
+
+/* MMAPMODE: extends the file (and, if needed, the mapping) so that
+   it holds page 'Page' */
+static void BufGrow(PAGENO Page) {
+    FilePages = Page + max(MAPCHUNK, FilePages / 2);
+    if (ftruncate(fileno(fpbtree), (off_t) (FilePages + 1) * PAGESIZE) != 0) {
+        perror("BufGrow: cannot extend B-TREE_FILE");
+        exit(-2);
+    }
+    if (FilePages > MapPages) {
+        munmap(MapBase, (size_t) (MapPages + 1) * PAGESIZE);
+        MapPages = 2 * FilePages;
+        BufMap();
+    }
+}
+
+/* allocates the frames; called by dbopen() once "fpbtree" is open
+   and its superblock is in memory */
+void BufInit(void) {
+    int f;
+
+    if (MMAPMODE) {
+        FilePages = max(ffsize(fpbtree) / PAGESIZE - 1, 0);
+        MapPages = max(2 * SuperBlk.NumPages, MAPCHUNK);
+        BufMap();
+        return;
+    }
+
+    Frames = (struct BufFrame *) malloc(sizeof(struct BufFrame) * POOLSIZE);
+    ck_malloc(Frames, "Frames in BufInit()");
+    HashSize = 2 * POOLSIZE + 1;
+    BufHash = (int *) malloc(sizeof(int) * HashSize);
+    ck_malloc(BufHash, "BufHash in BufInit()");
+    RunBuf = (char *) malloc((size_t) MAXRUN * PAGESIZE);
+    ck_malloc(RunBuf, "RunBuf in BufInit()");
+    DirtyList = (int *) malloc(sizeof(int) * POOLSIZE);
+    ck_malloc(DirtyList, "DirtyList in BufInit()");
+
+    for (f = 0; f < POOLSIZE; f++) {
+        Frames[f].PgNum = NULLPAGENO;
+        Frames[f].PinCount = 0;
+        Frames[f].Dirty = FALSE;
+        Frames[f].RefBit = FALSE;
+        Frames[f].HashNext = NOFRAME;
+        Frames[f].Image = (char *) malloc(PAGESIZE);
+        ck_malloc(Frames[f].Image, "Frames[f].Image in BufInit()");
+    }
+    for (f = 0; f < HashSize; f++)
+        BufHash[f] = NOFRAME;
+    ClockHand = 0;
+}
+
+/* pins page 'Page' in a frame and returns the frame number.
+   If 'Load' is FALSE the caller is about to overwrite the whole
+   image, so a missing page is not read from disk. */
+int BufPin(PAGENO Page, int Load) {
+    int f;
+
+    if (MMAPMODE) {
+        if (Page > FilePages)
+            BufGrow(Page);
+        return ((int) Page);
+    }
+
+    f = BufLookup(Page);
+    if (f != NOFRAME) {
+        if (Load)
+            bufHitCount++;
+    } else {
+        f = BufVictim();
+        Frames[f].PgNum = Page;
+        Frames[f].Dirty = FALSE;
+        Frames[f].HashNext = BufHash[Page % HashSize];
+        BufHash[Page % HashSize] = f;
+        if (Load) {
+            bufMissCount++;
+            fseek(fpbtree, (long) Page * PAGESIZE, 0);
+            if (fread(Frames[f].Image, 1, PAGESIZE, fpbtree) != PAGESIZE) {
+                printf("BufPin: short read on page %d\n", (int) Page);
+                exit(-1);
+            }
+        }
+    }
+
+    Frames[f].PinCount++;
+    Frames[f].RefBit = TRUE;
+    return (f);
+}
+
+/* returns the page image held in frame 'f' */
+char *BufImage(int f) {
+    if (MMAPMODE)
+        return (MapBase + (long) f * PAGESIZE);
+    return (Frames[f].Image);
+}
+
+/* releases one pin on frame 'f'; 'Dirty' is TRUE if the image changed */
+void BufUnpin(int f, int Dirty) {
+    if (MMAPMODE)
+        return;
+    assert(Frames[f].PinCount > 0);
+    Frames[f].PinCount--;
+    if (Dirty)
+        Frames[f].Dirty = TRUE;
+}
+
+/* orders frames by the page they hold, for qsort() */
+static int BufCmpPage(const void *a, const void *b) {
+    PAGENO pa = Frames[*(const int *) a].PgNum;
+    PAGENO pb = Frames[*(const int *) b].PgNum;
+
+    return ((pa > pb) - (pa < pb));
+}
+
+/* writes back every dirty frame, in order of page number, coalescing
+   consecutive pages into runs.  In MMAPMODE the kernel is only asked
+   to start writing back the modified pages. */
+void BufFlushAll(void) {
+    int f, n, i, len;
+
+    if (MMAPMODE) {
+        msync(MapBase, (size_t) (FilePages + 1) * PAGESIZE, MS_ASYNC);
+        return;
+    }
+    for (n = 0, f = 0; f < POOLSIZE; f++)
+        if ((Frames[f].PgNum != NULLPAGENO) && Frames[f].Dirty)
+            DirtyList[n++] = f;
+    qsort(DirtyList, n, sizeof(int), BufCmpPage);
+    for (i = 0; i < n; i += len) {
+        for (len = 1; (i + len < n) && (len < MAXRUN); len++)
+            if (Frames[DirtyList[i + len]].PgNum !=
+                Frames[DirtyList[i]].PgNum + len)
+                break;
+        BufWriteRun(DirtyList + i, len);
+    }
+    fflush(fpbtree);
+}
+
+/* writes back the dirty frames and releases the pool */
+void BufClose(void) {
+    int f;
+    off_t used = (off_t) (SuperBlk.NumPages + 1) * PAGESIZE;
+
+    BufFlushAll();
+    if (MMAPMODE) {
+        msync(MapBase, (size_t) (FilePages + 1) * PAGESIZE, MS_SYNC);
+        munmap(MapBase, (size_t) (MapPages + 1) * PAGESIZE);
+        MapBase = NULL;
+        /* drop the unused tail of the last chunk */
+        if (ftruncate(fileno(fpbtree), used) != 0)
+            perror("BufClose: cannot truncate B-TREE_FILE");
+        return;
+    }
+    for (f = 0; f < POOLSIZE; f++)
+        free(Frames[f].Image);
+    free(Frames);
+    free(BufHash);
+    free(RunBuf);
+    free(DirtyList);
+    Frames = NULL;
+    BufHash = NULL;
+    RunBuf = NULL;
+    DirtyList = NULL;
+}
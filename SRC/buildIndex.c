@@ -1,67 +1,109 @@
-/* builds an index on the given file "fptext"
+/* rebuilds the index from the file "fptext" (command "r"),
    which should consist of documents, each starting
-   with  TAG (=ctrl-V)
+   with  TAG (=ctrl-V).
+   B-TREE_FILE, POSTINGSFILE and DOCTABLE are made anew, as by the
+   bulk loader (bulkload.c), from TEXTFILE alone: the documents keep
+   their numbers, and the names of their files if DOCTABLE still has
+   them.  The documents are found at the TAGs of TEXTFILE, which is
+   mapped into memory (tokenize.c), and split into words by threads,
+   through the pipeline of ingest.c, in place; the words go to the
+   bulk loader in the order of the documents.
  */
 
 #include <stdio.h>
 #include "def.h"
 #include "defn.g"
 
-extern FILE *fpbtree, *fppost, *fptext;
+extern FILE *fptext;
 
-extern int inithash(void);
-extern int iscommon(char *word);
-extern int strtolow(char *s);
-extern int inhash(char *word);
-extern int InsertTree(char *Key, TEXTPTR TextOffset);
-extern int hfree(void);
+extern void dbopen(void);
+extern void dbclose(void);
+extern long ffsize(FILE *fp);
+extern void TokOpen(struct TokStream *T, FILE *fp);
+extern void TokRange(struct TokStream *T, struct TokStream *Whole,
+                     long Start, long End);
+extern void TokClose(struct TokStream *T);
+extern void TextWords(struct TokStream *T, struct HashTab *H);
+extern long IngRun(long Num, void (*Read)(long i, struct IngSlot *S),
+                   void (*Use)(long i, struct IngSlot *S));
+extern char **DocNames(TEXTPTR **pStarts, long *pNum);
+extern void BulkBegin(void);
+extern void BulkIndex(TEXTPTR Start, long Size, char *fname,
+                      struct HashTab *H);
+extern void BulkBuild(int FillPercent);
 
-void buildIndex(void) {
-    char word[MAXWORDSIZE];
-    TEXTPTR docStart; /* marks the beginning of a new document */
-    int getword(FILE * fp, char *word), hgetnext(char *word);
-    int c, i;
+static struct TokStream Text; /* TEXTFILE */
+static TEXTPTR *DocStart;     /* the TAGs of the documents */
+static long NumDocs;
+static char **OldNames; /* the names in the old DOCTABLE */
+static TEXTPTR *OldStart; /* ... and the offsets of their documents */
+static long NumOld;
 
-    docStart = 0;
-    i = TRUE;
-    inithash(); /* initialize the hash table */
-    while (i != EOF) {
-        fseek(fptext, (long) docStart, 0);
-        /* read first character and check for TAG */
-        if ((c = getc(fptext)) != TAG) {
-            printf("error in buildIndex.c - %ld is not a TAG\n",
-                   ftell(fptext) - 1);
-            exit(-1);
-        }
-        /* eliminate dupl. words by hashing into a h.table */
-        /* also, randomizes them somehow */
-        while (((i = getword(fptext, word)) != EOF) && (i != DOCSTART)) {
-            if (!iscommon(word)) {
-                strtolow(word); /* turn to lower case only */
-                inhash(word);
-            }
-        }
-#ifdef DEBUG
-        hprint(); /* just for testing */
-#endif
-
-        while (hgetnext(word) != EOH) {
-            InsertTree(word, docStart);
-        }
-
-#ifdef DEBUG
-        system("date; vmstat; echo freeing htab");
-#endif
+/* splits the document 'i' into words */
+static void RebuildRead(long i, struct IngSlot *S) {
+    struct TokStream tok;
 
-        hfree(); /* empties the hash table */
+    TokRange(&tok, &Text, DocStart[i] + 1,
+             (i + 1 < NumDocs) ? DocStart[i + 1] : Text.Len);
+    S->Len = tok.Len;
+    TextWords(&tok, &S->Tab);
+}
 
-#ifdef DEBUG
+/* gives the words of the document 'i' to the bulk loader */
+static void RebuildUse(long i, struct IngSlot *S) {
+    BulkIndex(DocStart[i], S->Len,
+              ((i < NumOld) && (OldStart[i] == DocStart[i])) ? OldNames[i] : "",
+              &S->Tab);
+}
 
-        system("date; vmstat");
-#endif
+void buildIndex(int fill) {
+    long i, maxdocs = 0, nthreads;
+    char *p;
 
-        if (i == DOCSTART) {
-            docStart = ftell(fptext) - 1;
+    if ((fill < 10) || (fill > 100)) {
+        printf("Error: fill factor must be between 10 and 100\n");
+        return;
+    }
+    /* read first character and check for TAG; each document ends at
+       the TAG of the next one */
+    rewind(fptext);
+    if ((getc(fptext) != TAG) && (ffsize(fptext) > 0)) {
+        printf("error in buildIndex.c - 0 is not a TAG - nothing done\n");
+        return;
+    }
+    rewind(fptext);
+    TokOpen(&Text, fptext); /* stays in memory after fptext is closed */
+    NumDocs = 0;
+    p = (Text.Len > 0) ? Text.Buf : NULL; /* at the first TAG */
+    while (p != NULL) {
+        if (NumDocs == maxdocs) {
+            maxdocs = max(2 * maxdocs, 1024);
+            DocStart = (TEXTPTR *) realloc(DocStart,
+                                           sizeof(TEXTPTR) * maxdocs);
+            ck_malloc(DocStart, "DocStart in buildIndex()");
         }
+        DocStart[NumDocs++] = p - Text.Buf;
+        p = memchr(p + 1, TAG, Text.Len - (p + 1 - Text.Buf));
     }
+
+    /* start over with an empty index */
+    dbclose();
+    OldNames = DocNames(&OldStart, &NumOld);
+    remove("B-TREE_FILE");
+    remove("POSTINGSFILE");
+    remove("DOCTABLE");
+    dbopen();
+
+    BulkBegin();
+    nthreads = (NumDocs > 0) ? IngRun(NumDocs, RebuildRead, RebuildUse) : 0;
+    BulkBuild(fill);
+
+    TokClose(&Text);
+    for (i = 0; i < NumOld; i++)
+        free(OldNames[i]);
+    free(OldNames);
+    free(OldStart);
+    free(DocStart);
+    DocStart = NULL;
+    printf("%ld documents, %ld threads\n", NumDocs, nthreads);
 }
@@ -0,0 +1,574 @@
+/* bulkbuild.c */
+
+/*  Builds the B-tree bottom-up from a stream of (word, document) pairs,
+    each with the term frequency of the word in the document (and, with
+    POSITIONS, its positions there), instead of inserting the pairs one
+    by one with InsertTree().
+
+    BulkBegin() starts a new build; BulkAdd() adds one pair; BulkBuild()
+    sorts the pairs and writes the tree.  The tree must be empty.
+
+    The pairs are collected in an arena of SORTMEM kilobytes (see
+    setparms.c).  Whenever the arena is full, its pairs are sorted by
+    (word, document) and written out as a sorted run, on a temporary
+    file.  BulkBuild() merges the runs (in several passes, if there are
+    more than MAXFANIN of them) and receives the pairs in order, so all
+    the documents of a word arrive together, in increasing order.
+
+    Each word gets a single postings record, appended to POSTINGSFILE;
+    its capacity is rounded up to the size class (LISTSIZE) that holds
+    its delta-coded documents, so that later insertions find it in the
+    format that UpdatePostingsFile() expects (see postrec.c).
+
+    The leaves are written left to right, in consecutive pages, filled
+    up to 'Fill' percent of PAGESIZE; the existing (empty) root page
+    becomes the first leaf.  Each level above is then built over the
+    pages of the level below, using as separator the high key of the
+    child on its left (KeySeparator(), see keycmp.c), and the root ends
+    up as the last page written.
+    The superblock records the new root and height.
+*/
+
+#include "def.h"
+
+#define MAXFANIN (64) /* most runs merged at once */
+
+extern FILE *fppost;
+extern int SORTMEM;
+extern long LISTSIZE[NUMLISTS];
+extern int SizeClass(long size);
+extern long PostEncode(DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where,
+                       NUMPTRS Num, unsigned char *Buf);
+extern int btWriteCount, pWriteCount, iCount; /* see stats.c */
+
+extern int BufPin(PAGENO Page, int Load);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern PAGENO getNewPageNum(void);
+extern int SlotCompare(char *Key, int KeyLen, char *Word, int WordLen);
+extern void SlotInit(char *Page, char Type, PAGENO PgNum, PAGENO Link);
+extern void SlotSetLink(char *Page, PAGENO Link);
+extern int SlotNumKeys(char *Page);
+extern int SlotMaxKeyLen(void);
+extern int SlotAppendBytes(char *Page, char *Key, int KeyLen);
+extern int SlotInsert(char *Page, int i, char *Key, int KeyLen, long Ptr);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern int KeySeparator(char *Left, int LeftLen, char *Right, int RightLen,
+                        char *Sep);
+
+/* A pair, as stored in the arena and in the run files:
+        the document            a DOCID
+        the term frequency      a POSTCOUNT
+        the word length         one byte
+        the word                not terminated
+        the positions           tf POSTCOUNTs, with POSITIONS only      */
+#define PAIRHDR		(sizeof(DOCID) + sizeof(POSTCOUNT))
+#define PairLen(p)	((unsigned char) (p)[PAIRHDR])
+#define PairWord(p)	((p) + PAIRHDR + 1)
+#define PairWhere(p)	(PairWord(p) + PairLen(p))
+#define PairSize(len, tf) \
+	(PAIRHDR + 1 + (len) + (POSITIONS ? (tf) * sizeof(POSTCOUNT) : 0))
+
+static char *Arena = NULL;   /* the pairs not yet written to a run */
+static long ArenaUsed, ArenaSize;
+static char **Sorted = NULL; /* pointers to the pairs in the arena */
+static long NumSorted, MaxSorted;
+static FILE **Runs = NULL;   /* the sorted runs, on temporary files */
+static int NumRuns, MaxRuns;
+static long NumPairs;
+
+/* A sorted run being merged */
+struct RunCursor {
+    FILE *fp;
+    DOCID Doc;
+    POSTCOUNT Tf;
+    int Len;
+    char Word[MAXWORDSIZE];
+    POSTCOUNT *Where; /* the positions, with POSITIONS */
+    POSTCOUNT MaxWhere;
+};
+
+/* A page of the level under construction, for the level above */
+struct LevelEntry {
+    PAGENO PgNum;
+    char *HighKey; /* >= every key under this page, and < the keys of
+                      the next page */
+};
+
+static struct LevelEntry *Level = NULL;
+static long LevelLen, LevelMax;
+
+/* the document of a pair; pairs are not aligned in the arena */
+static DOCID PairDoc(char *p) {
+    DOCID doc;
+
+    memcpy(&doc, p, sizeof(doc));
+    return (doc);
+}
+
+/* the tf of a pair */
+static POSTCOUNT PairTf(char *p) {
+    POSTCOUNT tf;
+
+    memcpy(&tf, p + sizeof(DOCID), sizeof(tf));
+    return (tf);
+}
+
+/* orders pairs by word, then by document */
+static int PairCmp(char *a, char *b) {
+    int res;
+
+    res = SlotCompare(PairWord(a), PairLen(a), PairWord(b), PairLen(b));
+    if (res != 0)
+        return (res);
+    return ((PairDoc(a) > PairDoc(b)) - (PairDoc(a) < PairDoc(b)));
+}
+
+static int PairPtrCmp(const void *a, const void *b) {
+    return (PairCmp(*(char **) a, *(char **) b));
+}
+
+/* sorts the pairs of the arena and writes them out as a new run */
+static void BulkSpill(void) {
+    FILE *fp;
+    long i;
+
+    if (NumSorted == 0)
+        return;
+    qsort(Sorted, NumSorted, sizeof(char *), PairPtrCmp);
+    if ((fp = tmpfile()) == NULL) {
+        perror("BulkSpill: cannot create a run file");
+        exit(-2);
+    }
+    for (i = 0; i < NumSorted; i++)
+        fwrite(Sorted[i], PairSize(PairLen(Sorted[i]), PairTf(Sorted[i])), 1,
+               fp);
+    rewind(fp);
+
+    if (NumRuns == MaxRuns) {
+        MaxRuns = max(2 * MaxRuns, MAXFANIN);
+        Runs = (FILE **) realloc(Runs, sizeof(FILE *) * MaxRuns);
+        ck_malloc(Runs, "Runs in BulkSpill()");
+    }
+    Runs[NumRuns++] = fp;
+    ArenaUsed = 0;
+    NumSorted = 0;
+}
+
+/* starts a new bulk build */
+void BulkBegin(void) {
+    ArenaSize = (long) SORTMEM * 1024;
+    Arena = (char *) malloc(ArenaSize);
+    ck_malloc(Arena, "Arena in BulkBegin()");
+    MaxSorted = ArenaSize / PairSize(1, 1) + 1;
+    Sorted = (char **) malloc(sizeof(char *) * MaxSorted);
+    ck_malloc(Sorted, "Sorted in BulkBegin()");
+    ArenaUsed = NumSorted = NumPairs = 0;
+    NumRuns = MaxRuns = 0;
+    Runs = NULL;
+}
+
+/* adds the pair (Word, Doc), where Word occurs Tf times, at the
+   positions 'Where' with POSITIONS; the pairs of one document must be
+   added together, without duplicates, and documents in increasing
+   order */
+void BulkAdd(char *Word, DOCID Doc, POSTCOUNT Tf, POSTCOUNT *Where) {
+    int len = strlen(Word);
+    char *p;
+
+    assert(len < MAXWORDSIZE);
+    if (ArenaUsed + PairSize(len, Tf) > ArenaSize)
+        BulkSpill();
+    if (PairSize(len, Tf) > ArenaSize) {
+        printf("BulkAdd: \"%s\" occurs too often for sortmem\n", Word);
+        exit(-2);
+    }
+    p = Arena + ArenaUsed;
+    memcpy(p, &Doc, sizeof(Doc));
+    memcpy(p + sizeof(DOCID), &Tf, sizeof(Tf));
+    p[PAIRHDR] = (char) len;
+    memcpy(PairWord(p), Word, len);
+    if (POSITIONS)
+        memcpy(PairWhere(p), Where, Tf * sizeof(POSTCOUNT));
+    ArenaUsed += PairSize(len, Tf);
+    Sorted[NumSorted++] = p;
+    NumPairs++;
+}
+
+/* reads the next pair of a run into the cursor; FALSE at the end */
+static int RunNext(struct RunCursor *rc) {
+    unsigned char len;
+
+    if (fread(&rc->Doc, sizeof(rc->Doc), 1, rc->fp) != 1)
+        return (FALSE);
+    if ((fread(&rc->Tf, sizeof(rc->Tf), 1, rc->fp) != 1) ||
+        (fread(&len, 1, 1, rc->fp) != 1) ||
+        (fread(rc->Word, 1, len, rc->fp) != len)) {
+        printf("RunNext: run file is truncated\n");
+        exit(-2);
+    }
+    rc->Len = len;
+    if (!POSITIONS)
+        return (TRUE);
+    if (rc->Tf > rc->MaxWhere) {
+        rc->MaxWhere = max(rc->Tf, 2 * rc->MaxWhere);
+        rc->Where = (POSTCOUNT *) realloc(rc->Where,
+                                          sizeof(POSTCOUNT) * rc->MaxWhere);
+        ck_malloc(rc->Where, "rc->Where in RunNext()");
+    }
+    if (fread(rc->Where, sizeof(POSTCOUNT), rc->Tf, rc->fp) != rc->Tf) {
+        printf("RunNext: run file is truncated\n");
+        exit(-2);
+    }
+    return (TRUE);
+}
+
+static int CursorCmp(struct RunCursor *a, struct RunCursor *b) {
+    int res;
+
+    res = SlotCompare(a->Word, a->Len, b->Word, b->Len);
+    if (res != 0)
+        return (res);
+    return ((a->Doc > b->Doc) - (a->Doc < b->Doc));
+}
+
+/* restores the heap order below Heap[i] */
+static void HeapDown(struct RunCursor **Heap, int n, int i) {
+    struct RunCursor *t;
+    int c;
+
+    while ((c = 2 * i + 1) < n) {
+        if ((c + 1 < n) && (CursorCmp(Heap[c + 1], Heap[c]) < 0))
+            c++;
+        if (CursorCmp(Heap[i], Heap[c]) <= 0)
+            break;
+        t = Heap[i];
+        Heap[i] = Heap[c];
+        Heap[c] = t;
+        i = c;
+    }
+}
+
+/* merges the runs In[0..n-1], calling 'Emit' for each pair in order,
+   and closes them */
+static void MergeRuns(FILE **In, int n,
+                      void (*Emit)(char *Word, int Len, DOCID Doc,
+                                   POSTCOUNT Tf, POSTCOUNT *Where)) {
+    struct RunCursor *Cur, **Heap;
+    int i, len;
+
+    Cur = (struct RunCursor *) malloc(sizeof(struct RunCursor) * n);
+    ck_malloc(Cur, "Cur in MergeRuns()");
+    Heap = (struct RunCursor **) malloc(sizeof(struct RunCursor *) * n);
+    ck_malloc(Heap, "Heap in MergeRuns()");
+    for (len = 0, i = 0; i < n; i++) {
+        Cur[i].fp = In[i];
+        Cur[i].Where = NULL;
+        Cur[i].MaxWhere = 0;
+        if (RunNext(&Cur[i]))
+            Heap[len++] = &Cur[i];
+    }
+    for (i = len / 2 - 1; i >= 0; i--)
+        HeapDown(Heap, len, i);
+
+    while (len > 0) {
+        Emit(Heap[0]->Word, Heap[0]->Len, Heap[0]->Doc, Heap[0]->Tf,
+             Heap[0]->Where);
+        if (!RunNext(Heap[0]))
+            Heap[0] = Heap[--len];
+        HeapDown(Heap, len, 0);
+    }
+
+    for (i = 0; i < n; i++) {
+        fclose(In[i]);
+        free(Cur[i].Where);
+    }
+    free(Cur);
+    free(Heap);
+}
+
+/* intermediate merge passes write their output to this run */
+static FILE *MergeOut;
+
+static void EmitToRun(char *Word, int Len, DOCID Doc, POSTCOUNT Tf,
+                      POSTCOUNT *Where) {
+    unsigned char len = (unsigned char) Len;
+
+    fwrite(&Doc, sizeof(Doc), 1, MergeOut);
+    fwrite(&Tf, sizeof(Tf), 1, MergeOut);
+    fwrite(&len, 1, 1, MergeOut);
+    fwrite(Word, 1, Len, MergeOut);
+    if (POSITIONS)
+        fwrite(Where, sizeof(POSTCOUNT), Tf, MergeOut);
+}
+
+/* the state of the leaf level, while the final merge runs */
+static int Fill;          /* bytes to fill each page up to */
+static int LeafFrame;     /* the leaf being filled, pinned */
+static PAGENO LeafPg;
+static char CurWord[MAXWORDSIZE + 1]; /* the word being collected */
+static int CurLen;
+static DOCID *Docs;     /* its documents */
+static POSTCOUNT *Tfs;    /* ... the frequencies of the word in them */
+static POSTCOUNT *Wheres; /* ... its positions there, with POSITIONS */
+static unsigned char *Code; /* ... and their encoding (postrec.c) */
+static NUMPTRS NumDocs, MaxDocs;
+static long NumWheres, MaxWheres;
+static POSTINGSPTR PostEnd; /* end of POSTINGSFILE */
+static long NumTerms, NumLeaves;
+
+/* appends a page to the level being built */
+static void LevelAdd(PAGENO PgNum, char *HighKey) {
+    if (LevelLen == LevelMax) {
+        LevelMax = max(2 * LevelMax, 1024);
+        Level = (struct LevelEntry *) realloc(Level,
+                                              sizeof(*Level) * LevelMax);
+        ck_malloc(Level, "Level in LevelAdd()");
+    }
+    Level[LevelLen].PgNum = PgNum;
+    Level[LevelLen].HighKey = HighKey;
+    LevelLen++;
+}
+
+/* writes the postings record of the current word at the end of
+   POSTINGSFILE and returns its offset */
+static POSTINGSPTR BulkPosting(void) {
+    POSTINGSPTR pptr = PostEnd;
+    struct PostHdr hdr;
+    long i;
+    int c;
+
+    Code = (unsigned char *) realloc(Code, PostBytes(NumDocs, NumWheres));
+    ck_malloc(Code, "Code in BulkPosting()");
+    hdr.NumPtrs = NumDocs;
+    hdr.NumBytes = PostEncode(Docs, Tfs, Wheres, NumDocs, Code);
+    for (hdr.MaxTf = 0, i = 0; i < NumDocs; i++)
+        hdr.MaxTf = max(hdr.MaxTf, Tfs[i]);
+    c = SizeClass(hdr.NumBytes);
+    pWriteCount++;
+    fwrite(&hdr.NumPtrs, sizeof(hdr.NumPtrs), 1, fppost);
+    fwrite(&hdr.NumBytes, sizeof(hdr.NumBytes), 1, fppost);
+    fwrite(&hdr.MaxTf, sizeof(hdr.MaxTf), 1, fppost);
+    fwrite(Code, 1, hdr.NumBytes, fppost);
+    for (i = hdr.NumBytes; i < LISTSIZE[c]; i++)
+        putc(0, fppost);
+    PostEnd += POSTHDRSIZE + LISTSIZE[c];
+    return (pptr);
+}
+
+/* the leaf being filled is complete: records it for the level above
+   and releases it.  (Next, NextLen) is the first key of the next leaf,
+   or NULL for the last leaf. */
+static void LeafDone(char *Next, int NextLen) {
+    char *Page = BufImage(LeafFrame);
+    char *key;
+    char sep[MAXWORDSIZE + 1];
+    int n, len;
+
+    n = SlotNumKeys(Page);
+    if (n > 0) { /* the high key: the last key, or less with a next leaf */
+        key = SlotKey(Page, n - 1, &len);
+        if (Next != NULL) {
+            len = KeySeparator(key, len, Next, NextLen, sep);
+            key = sep;
+        }
+        LevelAdd(LeafPg, (char *) malloc(len + 1));
+        ck_malloc(Level[LevelLen - 1].HighKey, "HighKey in LeafDone()");
+        memcpy(Level[LevelLen - 1].HighKey, key, len);
+        Level[LevelLen - 1].HighKey[len] = EOS;
+    }
+    BufUnpin(LeafFrame, TRUE);
+    btWriteCount++;
+    NumLeaves++;
+}
+
+/* adds the current word, with its postings, to the leaf level */
+static void LeafAddWord(void) {
+    char *Page = BufImage(LeafFrame);
+    POSTINGSPTR pptr;
+    PAGENO next;
+
+    if (NumDocs == 0)
+        return;
+    if (CurLen > SlotMaxKeyLen()) {
+        printf("ERROR: key is too long-operation aborted\n");
+        printf("offending key:\"%s\"\n", CurWord);
+        NumDocs = NumWheres = 0;
+        return;
+    }
+    pptr = BulkPosting();
+
+    if ((SlotNumKeys(Page) > 0) &&
+        (SlotAppendBytes(Page, CurWord, CurLen) > Fill)) {
+        /* the leaf is full: the next one is the following page */
+        next = getNewPageNum();
+        SlotSetLink(Page, next);
+        LeafDone(CurWord, CurLen);
+
+        LeafPg = next;
+        LeafFrame = BufPin(LeafPg, FALSE);
+        Page = BufImage(LeafFrame);
+        SlotInit(Page, LeafSymbol, LeafPg, NULLPAGENO);
+    }
+    SlotInsert(Page, SlotNumKeys(Page), CurWord, CurLen, pptr);
+
+    iCount += NumDocs;
+    NumTerms++;
+    NumDocs = NumWheres = 0;
+}
+
+/* receives the pairs of the final merge, in order */
+static void EmitToLeaf(char *Word, int Len, DOCID Doc, POSTCOUNT Tf,
+                       POSTCOUNT *Where) {
+    if ((Len != CurLen) || (memcmp(Word, CurWord, Len) != 0)) {
+        LeafAddWord();
+        memcpy(CurWord, Word, Len);
+        CurWord[Len] = EOS;
+        CurLen = Len;
+    }
+    if (NumDocs == MaxDocs) {
+        MaxDocs = max(2 * MaxDocs, 64);
+        Docs = (DOCID *) realloc(Docs, sizeof(DOCID) * MaxDocs);
+        Tfs = (POSTCOUNT *) realloc(Tfs, sizeof(POSTCOUNT) * MaxDocs);
+        ck_malloc(Docs, "Docs in EmitToLeaf()");
+        ck_malloc(Tfs, "Tfs in EmitToLeaf()");
+    }
+    Docs[NumDocs] = Doc;
+    Tfs[NumDocs++] = Tf;
+    if (!POSITIONS)
+        return;
+    if (NumWheres + Tf > MaxWheres) {
+        MaxWheres = max(2 * MaxWheres, NumWheres + Tf);
+        Wheres = (POSTCOUNT *) realloc(Wheres, sizeof(POSTCOUNT) * MaxWheres);
+        ck_malloc(Wheres, "Wheres in EmitToLeaf()");
+    }
+    memcpy(Wheres + NumWheres, Where, Tf * sizeof(POSTCOUNT));
+    NumWheres += Tf;
+}
+
+/* returns the number of children, starting at Level[first], that go
+   into one nonleaf page: the keys of all but the last child must fit */
+static long NonLeafSpan(long first) {
+    long end = first + 1;
+    int bytes = SP_SLOTS;
+
+    while ((end < LevelLen) &&
+           ((end - first == 1) ||
+            (bytes + SlotSize(strlen(Level[end - 1].HighKey)) <= Fill))) {
+        bytes += SlotSize(strlen(Level[end - 1].HighKey));
+        end++;
+    }
+
+    /* do not leave a single child for the last page */
+    if (LevelLen - end == 1) {
+        if (end - first >= 3)
+            end--;
+        else if (bytes + SlotSize(strlen(Level[end - 1].HighKey)) <= PAGESIZE)
+            end++;
+    }
+    return (end - first);
+}
+
+/* builds the level of nonleaf pages above the pages in Level[] and
+   replaces Level[] with it */
+static void NonLeafLevel(void) {
+    long first, n, i, up;
+    PAGENO pg;
+    char *Page;
+    int Frame;
+
+    for (first = 0, up = 0; first < LevelLen; first += n) {
+        n = NonLeafSpan(first);
+        pg = getNewPageNum();
+        Frame = BufPin(pg, FALSE);
+        Page = BufImage(Frame);
+        SlotInit(Page, NonLeafSymbol, pg, Level[first + n - 1].PgNum);
+        for (i = 0; i < n - 1; i++) {
+            SlotInsert(Page, (int) i, Level[first + i].HighKey,
+                       strlen(Level[first + i].HighKey),
+                       Level[first + i].PgNum);
+            free(Level[first + i].HighKey);
+        }
+        BufUnpin(Frame, TRUE);
+        btWriteCount++;
+
+        /* the new page takes the place of its children */
+        Level[up].PgNum = pg;
+        Level[up].HighKey = Level[first + n - 1].HighKey;
+        up++;
+    }
+    LevelLen = up;
+}
+
+/* sorts the pairs added so far and builds the tree, filling its
+   pages up to 'FillPercent' percent */
+void BulkBuild(int FillPercent) {
+    int i;
+
+    BulkSpill();
+    free(Arena);
+    free(Sorted);
+    Arena = NULL;
+    Sorted = NULL;
+
+    /* cut the number of runs down to MAXFANIN */
+    while (NumRuns > MAXFANIN) {
+        if ((MergeOut = tmpfile()) == NULL) {
+            perror("BulkBuild: cannot create a run file");
+            exit(-2);
+        }
+        MergeRuns(Runs, MAXFANIN, EmitToRun);
+        rewind(MergeOut);
+        for (i = MAXFANIN; i < NumRuns; i++)
+            Runs[i - MAXFANIN] = Runs[i];
+        NumRuns -= MAXFANIN;
+        Runs[NumRuns++] = MergeOut;
+    }
+
+    /* the leaf level: the empty root is the first leaf */
+    Fill = max(FillPercent * PAGESIZE / 100, SP_SLOTS);
+    gotoeof(fppost);
+    PostEnd = ftell(fppost);
+    CurLen = 0;
+    NumDocs = MaxDocs = 0;
+    NumWheres = MaxWheres = 0;
+    Docs = NULL;
+    Tfs = NULL;
+    Wheres = NULL;
+    Code = NULL;
+    NumTerms = NumLeaves = 0;
+    LevelLen = LevelMax = 0;
+    LeafPg = ROOT;
+    LeafFrame = BufPin(LeafPg, FALSE);
+    SlotInit(BufImage(LeafFrame), LeafSymbol, LeafPg, NULLPAGENO);
+
+    MergeRuns(Runs, NumRuns, EmitToLeaf);
+    LeafAddWord();
+    LeafDone(NULL, 0);
+    free(Runs);
+    free(Docs);
+    free(Tfs);
+    free(Wheres);
+    free(Code);
+    Runs = NULL;
+    Docs = NULL;
+    Tfs = NULL;
+    Wheres = NULL;
+    Code = NULL;
+
+    /* the levels above, up to a single root */
+    SuperBlk.Height = 1;
+    while (LevelLen > 1) {
+        NonLeafLevel();
+        SuperBlk.Height++;
+    }
+    if (LevelLen == 1) { /* else there were no words at all */
+        SuperBlk.RootPg = Level[0].PgNum;
+        free(Level[0].HighKey);
+    }
+    free(Level);
+    Level = NULL;
+
+    printf("%ld pairs, %ld words, %ld leaves, height %d\n", NumPairs,
+           NumTerms, NumLeaves, SuperBlk.Height);
+}
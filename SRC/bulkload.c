@@ -0,0 +1,100 @@
+/* loads the files named in the list file 'listname' (one name per
+   line) into an empty database, building the B-tree bottom-up
+   (see bulkbuild.c) instead of inserting word by word.
+   Each file is appended to "TEXTFILE", PREFIXED with a TAG (ctrl-V),
+   and split into words, by TextAppend() and TextWords() (see insert.c),
+   as insert() does; BulkIndex() gives the words to the bulk loader, as
+   TextIndex() gives them to the insertions.  The rebuild of the index
+   (buildIndex.c) goes through BulkIndex() too.
+ */
+
+#include <stdio.h>
+#include "def.h"
+#include "defn.g"
+
+extern void inithash(struct HashTab *H);
+extern void TokOpen(struct TokStream *T, FILE *fp);
+extern void TokClose(struct TokStream *T);
+extern int hgetnext(struct HashTab *H, char **word);
+extern POSTCOUNT *hpositions(struct HashTab *H);
+extern void hfree(struct HashTab *H);
+extern void hclose(struct HashTab *H);
+extern int BufPin(PAGENO Page, int Load);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotNumKeys(char *Page);
+extern void BulkBegin(void);
+extern void BulkAdd(char *Word, DOCID Doc, POSTCOUNT Tf, POSTCOUNT *Where);
+extern DOCID DocAdd(TEXTPTR Start, long Size, long Len, char *Name);
+extern long DocCount(void);
+extern void BulkBuild(int FillPercent);
+extern TEXTPTR TextAppend(char *Text, long Len);
+extern void TextWords(struct TokStream *T, struct HashTab *H);
+
+/* gives the words of 'H' to the bulk loader, for the next document,
+   which is at 'Start' in TEXTFILE, 'Size' bytes long, from the file
+   'fname' */
+void BulkIndex(TEXTPTR Start, long Size, char *fname, struct HashTab *H) {
+    char *word;
+    DOCID doc = DocCount(); /* the number the document gets */
+    long len = 0;           /* words indexed, with repetitions */
+    int n;
+
+    while ((n = hgetnext(H, &word)) != EOH) {
+        BulkAdd(word, doc, n, hpositions(H));
+        len += n;
+    }
+    DocAdd(Start, Size, len, fname);
+}
+
+void bulkload(char *listname, int fill) {
+    char fname[1024];
+    struct TokStream tok;
+    struct HashTab tab;
+    TEXTPTR StartNewText; /* Offset to newly concatenated document */
+    FILE *fplist, *fpdoc;
+    int Frame, empty;
+
+    /* the tree must consist of the empty root */
+    Frame = BufPin(ROOT, TRUE);
+    empty = IsLeafImage(BufImage(Frame)) && (SlotNumKeys(BufImage(Frame)) == 0);
+    BufUnpin(Frame, FALSE);
+    if (!empty) {
+        printf("Error: bulk loading needs an empty index\n");
+        return;
+    }
+    if ((fill < 10) || (fill > 100)) {
+        printf("Error: fill factor must be between 10 and 100\n");
+        return;
+    }
+    if ((fplist = fopen(listname, "r")) == NULL) {
+        printf("Error: Cannot Open List File: %s\n", listname);
+        return;
+    }
+
+    BulkBegin();
+    inithash(&tab);
+    while (fscanf(fplist, "%1023s", fname) == 1) {
+        if ((fpdoc = fopen(fname, "r")) == NULL) {
+            printf("Error: Cannot Open Input Word File: %s\n", fname);
+            continue;
+        }
+
+        /* Concatenate the new text file to the file "TEXTFILE" */
+        TokOpen(&tok, fpdoc);
+        StartNewText = TextAppend(tok.Buf, tok.Len);
+
+        /* eliminate dupl. words by hashing into a h.table, which counts
+           them */
+        TextWords(&tok, &tab);
+        BulkIndex(StartNewText, tok.Len, fname, &tab);
+        hfree(&tab);
+        TokClose(&tok);
+
+        fclose(fpdoc);
+    }
+    fclose(fplist);
+    hclose(&tab);
+
+    BulkBuild(fill);
+}
@@ -0,0 +1,174 @@
+/* cmpbench.c */
+
+/*  Microbenchmark of the key comparators ("make cmpbench").
+
+    Reads text from the standard input (the Datafiles), builds the
+    sorted vocabulary of its words (lower case, as they are indexed),
+    and times
+        - the original CompareKeys(), which called strlen() on both
+          keys at every character (kept here as OldCompareKeys()),
+        - the current CompareKeys(), on terminated strings,
+        - memcmp() on keys of known length, as SlotCompare() compares
+          them in the page searches (slotpage.c),
+    first on random pairs of words and then in binary searches of every
+    word in the vocabulary.  All comparators must agree with strcmp().
+*/
+
+#include "def.h"
+#include <ctype.h>
+#include <time.h>
+
+#define NPAIRS (4000000L) /* random pairs compared */
+
+extern int CompareKeys(char *Key, char *Word);
+
+/* the comparator as it was, for reference */
+static int OldCompareKeys(char *Key, char *Word) {
+    int m = max(strlen(Key), strlen(Word));
+
+    int i = 0;
+    for (i = 0; i < m; i++) {
+        if (i >= strlen(Key)) {
+            return (1);
+        } else if (i >= strlen(Word)) {
+            return (2);
+        } else if (Key[i] < Word[i]) {
+            return (1);
+        } else if (Key[i] > Word[i]) {
+            return (2);
+        }
+    }
+    return (0);
+}
+
+static char **Words; /* the vocabulary, sorted */
+static int *Lens;
+static long NumWords;
+
+static int cmpstr(const void *a, const void *b) {
+    return (strcmp(*(char **) a, *(char **) b));
+}
+
+/* reads the words of the standard input, and keeps each once */
+static void ReadVocabulary(void) {
+    char word[MAXWORDSIZE];
+    long max = 1024, n = 0, i;
+    int c, len;
+
+    Words = (char **) malloc(sizeof(char *) * max);
+    ck_malloc(Words, "Words");
+    for (;;) {
+        while (((c = getchar()) != EOF) && !isalpha(c))
+            ;
+        if (c == EOF)
+            break;
+        for (len = 0; (c != EOF) && isalpha(c); c = getchar())
+            if (len < MAXWORDSIZE - 1)
+                word[len++] = tolower(c);
+        word[len] = EOS;
+        if (n == max) {
+            max *= 2;
+            Words = (char **) realloc(Words, sizeof(char *) * max);
+            ck_malloc(Words, "Words");
+        }
+        Words[n] = (char *) malloc(len + 1);
+        strcpy(Words[n++], word);
+    }
+    qsort(Words, n, sizeof(char *), cmpstr);
+
+    for (NumWords = 0, i = 0; i < n; i++)
+        if ((NumWords == 0) || (strcmp(Words[NumWords - 1], Words[i]) != 0))
+            Words[NumWords++] = Words[i];
+    Lens = (int *) malloc(sizeof(int) * NumWords);
+    for (i = 0; i < NumWords; i++)
+        Lens[i] = strlen(Words[i]);
+}
+
+/* maps each comparator to <0, 0, >0 */
+static int Compare(int How, long a, long b) {
+    int res;
+
+    switch (How) {
+    case 0:
+        res = OldCompareKeys(Words[a], Words[b]);
+        return ((res == 1) ? -1 : (res == 2));
+    case 1:
+        res = CompareKeys(Words[a], Words[b]);
+        return ((res == 1) ? -1 : (res == 2));
+    default:
+        res = memcmp(Words[a], Words[b], min(Lens[a], Lens[b]));
+        return ((res != 0) ? res : Lens[a] - Lens[b]);
+    }
+}
+
+#define NHOW (3)
+static char *Names[NHOW] = {"old CompareKeys", "CompareKeys", "memcmp"};
+
+static double Elapsed(clock_t start) {
+    return ((double) (clock() - start) / CLOCKS_PER_SEC);
+}
+
+int main(void) {
+    long *A, *B, i, low, high, mid, ncmp;
+    int how, res, sign;
+    long sum; /* printed, so that the loop is not optimized away */
+    clock_t start;
+    double t;
+
+    ReadVocabulary();
+    if (NumWords < 2) {
+        printf("cmpbench: give the words on the standard input\n");
+        exit(-1);
+    }
+    printf("%ld distinct words\n", NumWords);
+
+    srand(1);
+    A = (long *) malloc(sizeof(long) * NPAIRS);
+    B = (long *) malloc(sizeof(long) * NPAIRS);
+    for (i = 0; i < NPAIRS; i++) {
+        A[i] = rand() % NumWords;
+        B[i] = rand() % NumWords;
+    }
+
+    for (how = 0; how < NHOW; how++) {
+        /* random pairs */
+        start = clock();
+        for (sum = 0, i = 0; i < NPAIRS; i++)
+            sum += Compare(how, A[i], B[i]);
+        t = Elapsed(start);
+        for (i = 0; i < NPAIRS; i += 97) {
+            res = Compare(how, A[i], B[i]);
+            sign = strcmp(Words[A[i]], Words[B[i]]);
+            if ((res > 0) != (sign > 0) || (res < 0) != (sign < 0)) {
+                printf("%s disagrees with strcmp on %s, %s\n", Names[how],
+                       Words[A[i]], Words[B[i]]);
+                exit(-1);
+            }
+        }
+        printf("%-16s random pairs: %6.1f ns/compare", Names[how],
+               1e9 * t / NPAIRS);
+
+        /* binary search of every word */
+        start = clock();
+        for (ncmp = 0, i = 0; i < NumWords; i++) {
+            low = 0;
+            high = NumWords;
+            while (low < high) {
+                mid = (low + high) / 2;
+                ncmp++;
+                if (Compare(how, i, mid) > 0)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            if (low != i) {
+                printf("\n%s: binary search for %s failed\n", Names[how],
+                       Words[i]);
+                exit(-1);
+            }
+        }
+        t = Elapsed(start);
+        printf(", searches: %6.1f ns/compare (%ld)\n", 1e9 * t / ncmp, sum);
+    }
+    return (0);
+}
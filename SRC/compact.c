@@ -0,0 +1,234 @@
+/* compact.c */
+
+/*  Compacts POSTINGSFILE (command "K").  The records that postings
+    lists outgrow go to the free lists (freerec.c), and are reused only
+    by records of the same size class, so the file keeps growing, and
+    the records of neighbouring keys end up far apart.
+
+    PostCompact() walks the leaves in key order, and copies the record
+    of each key to the end of a new file, POSTINGSFILE.tmp, with
+    the capacity of its size class, as the bulk loader does
+    (bulkbuild.c): the records follow each other in the order of their
+    keys, with no free record in between, and the free lists are empty.
+    A second walk of the leaves then points their keys to the new
+    records, in place, and the new file is renamed over POSTINGSFILE.
+
+    The two files cannot change together, so the superblock says which
+    one is live.  Once the new file and the leaves as they were are on
+    disk (fsync()), the flag SB_COMPACTING is set in the superblock,
+    which is written and synced: from then on, POSTINGSFILE.tmp is the
+    postings file, whatever the leaves point to.  The leaves are
+    updated and synced, the file is renamed, the directory synced, and
+    the flag cleared.  If the program stops before the flag is set,
+    POSTINGSFILE and the leaves are as they were, and the new file is
+    left over, to be overwritten by the next "K".  If it stops while
+    the flag is set, dbopen() calls CompactRecover(), which walks the
+    leaves again, pointing the keys in order to the records of
+    POSTINGSFILE.tmp, as they follow each other there, and finishes
+    the job; after the rename, only the flag is left to clear.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "def.h"
+
+#define COMPACTNAME "POSTINGSFILE.tmp"
+
+extern FILE *fppost, *fpbtree;
+extern long LISTSIZE[NUMLISTS];
+extern POSTINGSPTR FreeHead[NUMLISTS];
+extern int pWriteCount;
+
+extern char *PinPage(PAGENO Page, int *pFrame);
+extern void BufUnpin(int f, int Dirty);
+extern void BufFlushAll(void);
+extern void SuperWrite(void);
+extern void FreeRead(void);
+extern int SlotNumKeys(char *Page);
+extern long SlotPtr(char *Page, int i);
+extern void SlotSetPtr(char *Page, int i, long Ptr);
+extern PAGENO SlotLink(char *Page);
+extern int SizeClass(long size);
+extern unsigned char *PostRead(POSTINGSPTR pptr, struct PostHdr *Hdr);
+extern void PostReadHdr(POSTINGSPTR pptr, struct PostHdr *Hdr);
+extern long ffsize(FILE *fp);
+
+/* the leftmost leaf, pinned */
+static char *FirstLeaf(int *pFrame) {
+    char *p;
+    int frame;
+
+    p = PinPage(ROOT, pFrame);
+    while (IsNonLeafImage(p)) {
+        frame = *pFrame;
+        p = PinPage(SlotPtr(p, 0), pFrame);
+        BufUnpin(frame, FALSE);
+    }
+    return (p);
+}
+
+/* appends the record at 'pptr' of POSTINGSFILE to 'fp', and returns
+   its offset there */
+static POSTINGSPTR CompactRecord(POSTINGSPTR pptr, FILE *fp) {
+    POSTINGSPTR newptr = ftell(fp);
+    struct PostHdr hdr;
+    unsigned char *buf;
+    long i;
+
+    buf = PostRead(pptr, &hdr);
+    pWriteCount++;
+    fwrite(&hdr.NumPtrs, sizeof(hdr.NumPtrs), 1, fp);
+    fwrite(&hdr.NumBytes, sizeof(hdr.NumBytes), 1, fp);
+    fwrite(&hdr.MaxTf, sizeof(hdr.MaxTf), 1, fp);
+    fwrite(buf, 1, hdr.NumBytes, fp);
+    for (i = hdr.NumBytes; i < LISTSIZE[SizeClass(hdr.NumBytes)]; i++)
+        putc(0, fp);
+    free(buf);
+    return (newptr);
+}
+
+/* the record after the one at 'pptr' in the compacted file, fppost */
+static POSTINGSPTR NextRecord(POSTINGSPTR pptr) {
+    struct PostHdr hdr;
+
+    PostReadHdr(pptr, &hdr);
+    return (pptr + POSTHDRSIZE + LISTSIZE[SizeClass(hdr.NumBytes)]);
+}
+
+/* points the keys, in key order, to the records of the compacted file,
+   fppost: to 'Ptrs', or, if it is NULL, to its records one after the
+   other.  Returns the number of keys. */
+static long CompactPoint(POSTINGSPTR *Ptrs) {
+    POSTINGSPTR ptr = NUMLISTS * sizeof(POSTINGSPTR); /* the first one */
+    int frame, tempFrame, i, n;
+    long k;
+    char *p;
+
+    for (k = 0, p = FirstLeaf(&frame);;) {
+        n = SlotNumKeys(p);
+        for (i = 0; i < n; i++, k++) {
+            if (Ptrs != NULL)
+                ptr = Ptrs[k];
+            SlotSetPtr(p, i, ptr);
+            if (Ptrs == NULL)
+                ptr = NextRecord(ptr);
+        }
+        if (SlotLink(p) == NULLPAGENO)
+            break;
+        tempFrame = frame;
+        p = PinPage(SlotLink(p), &frame);
+        BufUnpin(tempFrame, n > 0);
+    }
+    BufUnpin(frame, n > 0);
+    return (k);
+}
+
+/* puts the dirty pages and the superblock on disk */
+static void CompactSync(void) {
+    BufFlushAll();
+    SuperWrite();
+    if (fsync(fileno(fpbtree)) != 0) {
+        perror("compact: cannot sync B-TREE_FILE");
+        exit(-1);
+    }
+}
+
+/* makes the compacted file POSTINGSFILE, after CompactPoint(), unless
+   it is already ('Renamed'), and clears SB_COMPACTING */
+static void CompactCommit(int Renamed) {
+    int dir;
+
+    CompactSync(); /* the leaves point to the new file */
+    if (!Renamed && (rename(COMPACTNAME, "POSTINGSFILE") != 0)) {
+        perror("compact: " COMPACTNAME " stays the postings file");
+        return;
+    }
+    if (((dir = open(".", O_RDONLY)) < 0) || (fsync(dir) != 0)) {
+        perror("compact: cannot sync the directory");
+        exit(-1);
+    }
+    close(dir);
+    SuperBlk.Flags &= ~SB_COMPACTING;
+    CompactSync();
+}
+
+/* finishes a compaction that was cut short after it set SB_COMPACTING;
+   called by dbopen(), with POSTINGSFILE open, if it finds the flag */
+void CompactRecover(void) {
+    FILE *fp;
+
+    if ((fp = fopen(COMPACTNAME, "r+")) == NULL) { /* renamed already */
+        CompactCommit(TRUE);
+        return;
+    }
+    printf("compact: finishing the compaction of POSTINGSFILE\n");
+    fclose(fppost);
+    fppost = fp;
+    FreeRead(); /* none */
+    CompactPoint(NULL);
+    CompactCommit(FALSE);
+}
+
+/* rewrites POSTINGSFILE with no free records, the records in the order
+   of their keys */
+void PostCompact(void) {
+    POSTINGSPTR *ptrs = NULL, empty = -1;
+    long nkeys = 0, maxkeys = 0, k, before;
+    int frame, tempFrame, i, n;
+    FILE *fp;
+    char *p;
+
+    if ((fp = fopen(COMPACTNAME, "w+")) == NULL) {
+        printf("compact: cannot create %s - nothing done\n", COMPACTNAME);
+        return;
+    }
+    for (i = 0; i < NUMLISTS; i++) /* no free records */
+        fwrite(&empty, sizeof(empty), 1, fp);
+
+    /* copy the records, in key order */
+    for (p = FirstLeaf(&frame);;) {
+        n = SlotNumKeys(p);
+        if (nkeys + n > maxkeys) {
+            maxkeys = max(2 * maxkeys, nkeys + n + 1024);
+            ptrs = (POSTINGSPTR *) realloc(ptrs,
+                                           sizeof(POSTINGSPTR) * maxkeys);
+            ck_malloc(ptrs, "ptrs in PostCompact()");
+        }
+        for (i = 0; i < n; i++)
+            ptrs[nkeys++] = CompactRecord(SlotPtr(p, i), fp);
+        if (SlotLink(p) == NULLPAGENO)
+            break;
+        tempFrame = frame;
+        p = PinPage(SlotLink(p), &frame);
+        BufUnpin(tempFrame, FALSE);
+    }
+    BufUnpin(frame, FALSE);
+
+    /* the new file, and the tree it was made from, reach the disk */
+    if ((fflush(fp) != 0) || (fsync(fileno(fp)) != 0)) {
+        perror("compact: POSTINGSFILE is left as it was");
+        fclose(fp);
+        remove(COMPACTNAME);
+        free(ptrs);
+        return;
+    }
+    CompactSync();
+
+    /* the new file becomes the live one */
+    SuperBlk.Flags |= SB_COMPACTING;
+    CompactSync();
+    before = ffsize(fppost);
+    fclose(fppost);
+    fppost = fp;
+    for (i = 0; i < NUMLISTS; i++)
+        FreeHead[i] = -1;
+
+    /* the keys point to the new records, and it takes the name */
+    k = CompactPoint(ptrs);
+    assert(k == nkeys);
+    CompactCommit(FALSE);
+    free(ptrs);
+
+    printf("compact: %ld records, %ld bytes, down from %ld\n", nkeys,
+           ffsize(fppost), before);
+}
@@ -6,8 +6,17 @@
 
 extern FILE *fppost, *fpbtree, *fptext;
 
+extern void BufClose(void);
+extern void dbsync(void);
+extern void DocClose(void);
+extern void AccFlush(void);
+
 void dbclose(void) {
+    AccFlush(); /* the postings that the insertions collected */
+    dbsync();   /* writes back the dirty pages and the superblock */
+    BufClose(); /* releases the buffer pool */
     fclose(fppost);
     fclose(fpbtree);
     fclose(fptext);
+    DocClose();
 }
@@ -1,4 +1,5 @@
-/* opens or creates the three files (btree, postings & text files) */
+/* opens or creates the three files (btree, postings & text files),
+   and the table of the documents (see doctable.c) */
 
 /* modified by Frank Andrasco to initialize the first record of postings file*/
 
@@ -9,6 +10,12 @@ FILE *fppost, *fpbtree, *fptext;
 
 extern int initializePostingsFile(void);
 extern int CreateRoot(void);
+extern void BufInit(void);
+extern void SuperInit(void);
+extern void SuperRead(void);
+extern void FreeRead(void);
+extern void DocOpen(void);
+extern void CompactRecover(void);
 extern FILE *fopen(const char *, const char *);
 
 void dbopen(void) {
@@ -17,11 +24,19 @@ void dbopen(void) {
         fppost = fopen("POSTINGSFILE", "w+");
         initializePostingsFile();
     }
+    FreeRead(); /* the heads of the free lists stay in memory */
 
     if ((fpbtree = fopen("B-TREE_FILE", "r+")) == NULL) {
         printf("Creating B-tree file...\n");
         fpbtree = fopen("B-TREE_FILE", "w+");
+        SuperInit();
+        BufInit();
         CreateRoot(); /* an empty root page */
+    } else {
+        SuperRead();
+        BufInit();
+        if (SuperBlk.Flags & SB_COMPACTING)
+            CompactRecover(); /* "K" was cut short */
     }
     if ((fptext = fopen("TEXTFILE", "r+")) == NULL) {
         printf("Creating text file...\n");
@@ -31,4 +46,5 @@ void dbopen(void) {
             fptext = fopen("TEXTFILE", "r");
         }
     }
+    DocOpen();
 }
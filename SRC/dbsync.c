@@ -0,0 +1,23 @@
+/* writes out whatever is buffered for the three files (btree, postings
+   & text files): the dirty pages of the buffer pool, the superblock, the
+   heads of the postings free lists and the stdio buffers, also that of
+   the document table.  Called at the end of every command, and by
+   dbclose(). */
+
+#include <stdio.h>
+#include "def.h"
+
+extern FILE *fppost, *fpbtree, *fptext, *fpdoctable;
+
+extern void BufFlushAll(void);
+extern void SuperWrite(void);
+extern void FreeWrite(void);
+
+void dbsync(void) {
+    BufFlushAll(); /* sorted, coalesced write-back; see bufpool.c */
+    SuperWrite();  /* flushes fpbtree, too */
+    FreeWrite();   /* the heads of the postings free lists */
+    fflush(fppost);
+    fflush(fptext);
+    fflush(fpdoctable);
+}
@@ -20,9 +20,19 @@ extern int PAGESIZE;	/* Size of page (in bytes) to be stored on disk  */
 extern int MAXTEXTPTRS;	/* POSTINGSFILE stores so many ptrs,
 			   then goes to overflow */
 extern int fetchCounts;
+extern int POOLSIZE;	/* Number of page frames in the buffer pool */
+extern int MMAPMODE;	/* TRUE: B-TREE_FILE is accessed through mmap() */
+extern int SORTMEM;	/* memory for sorting in the bulk loader, in KB */
+extern int BATCHMEM;	/* memory for the postings of the insertions, in
+			   KB (see accum.c) */
+extern int POSITIONS;	/* TRUE: the postings keep the positions of the
+			   words in the documents (see postrec.c) */
+extern int THREADS;	/* threads that read the files in "I" (see
+			   ingest.c); 0: one per processor */
 
 #define MAXWORDSIZE (100) /* Maximum size of any key */
-#define ROOT (1)          /* The root is always stored as first page on disk */
+#define NUMLISTS (100)    /* size classes of postings records (freelist.c) */
+#define ROOT (SuperBlk.RootPg) /* The root page, recorded in the superblock */
 #define FIRSTLEAFPG (2)   /* The page number of first (orginal) leaf page */
 #define LeafSymbol ('L')     /* To differentiate a Leaf page */  
 #define NonLeafSymbol ('N')  /* To differentiate a Nonleaf page */
@@ -33,17 +43,171 @@ extern int fetchCounts;
 #define EOH		(-1)	/* end of the hash table */
 #define NULLPAGENO	(-3)	/* null page pointer */
 #define NONEXISTENT	(-2)
+#define NOFRAME		(-1)	/* page image not pinned in the buffer pool */
 
 typedef long PAGENO;
 typedef long TEXTPTR;
+typedef int  DOCID;        /* a document: its number in DOCTABLE, from 0
+                              in the order they were added (doctable.c) */
 typedef long POSTINGSPTR;
 typedef int  KEYLEN;
 typedef int  NUMKEYS;
 typedef int  NUMBYTES; 
 typedef long  NUMPTRS;     /* needed to make contiguous postings easier */
+typedef unsigned int POSTCOUNT; /* a field of a postings record header */
+typedef unsigned short SLOT; /* offset of a key within a page image */
+
+/* The superblock: the first PAGESIZE bytes of B-TREE_FILE (see
+   superblock.c).  It stays in memory while the index is open. */
+#define BTMAGIC		(0x42545245L)	/* "BTRE" */
+#define BTVERSION	(6)	/* format of the page images and of the
+				   postings records */
+
+struct SuperBlock {
+     long             Magic;
+     int              Version;
+     int              PageSize;
+     PAGENO           NumPages;   /* pages in the tree, superblock excluded */
+     PAGENO           RootPg;
+     int              Height;     /* levels; 1 while the root is a leaf */
+     int              Flags;      /* SB_... */
+};
+
+#define SB_POSITIONS	(1)	/* the postings keep word positions */
+#define SB_COMPACTING	(2)	/* POSTINGSFILE.tmp is the live postings
+				   file (see compact.c) */
+
+extern struct SuperBlock SuperBlk;
+
+/* The header of a postings record, followed by its delta-coded
+   documents, their term frequencies, and, with POSITIONS, the positions
+   of the word in the documents (see postrec.c) */
+struct PostHdr {
+     POSTCOUNT        NumPtrs;    /* documents in the record */
+     POSTCOUNT        NumBytes;   /* bytes of encoded postings */
+     POSTCOUNT        MaxTf;      /* largest term frequency */
+};
+
+#define POSTHDRSIZE	(3 * sizeof(POSTCOUNT))
+#define MAXVARINT	(10)	/* bytes of the longest varint */
+#define BLOCKSIZE	(128)	/* documents in a packed block */
+/* bytes of a block: its largest document, the bits per delta and per
+   tf, the packed deltas and the packed tfs (see bitpack.c) */
+#define BLOCKHDRSIZE	(sizeof(DOCID) + 2)
+#define BlockBytes(bits, tfbits) \
+	(BLOCKHDRSIZE + BLOCKSIZE / 8 * ((bits) + (tfbits)))
+#define BITPACKSLACK	(32)	/* the decoders read past a block so far */
+/* room to leave past the end of the encoded postings of a record in
+   memory, to pack its tail into a block, or to decode its last block */
+#define POSTSLACK	(BlockBytes(32, 32) + BITPACKSLACK)
+/* room to encode 'num' postings with 'npos' positions in all */
+#define PostBytes(num, npos)	((num) * 2 * MAXVARINT + (npos) * MAXVARINT)
+
+/* A cursor over the documents of a postings list (see postcursor.c).
+   It decodes one block of the record at a time: the block, or the
+   tail, numbered Block (NumBlocks for the tail). */
+#define ENDOFLIST	((DOCID) (~0U >> 1))	/* past the last document */
+
+struct PostCursor {
+     unsigned char   *Buf;        /* the encoded postings (postrec.c) */
+     long             Bytes;      /* ... their length */
+     DOCID           *SkipMax;    /* the last document of each block */
+     long            *SkipOff;    /* ... and where it starts in Buf; the
+                                     tail starts at SkipOff[NumBlocks] */
+     NUMPTRS          NumBlocks;
+     NUMPTRS          Block;      /* the one decoded, or -1 */
+     DOCID           *Docs;       /* its documents, increasing */
+     POSTCOUNT       *Tfs;        /* ... and their term frequencies */
+     POSTCOUNT       *Where;      /* the positions of the word, if asked
+                                     for: Tfs[i] of them for Docs[i] */
+     NUMPTRS         *WhereAt;    /* where those of Docs[i] start */
+     int              WantWhere;
+     POSTCOUNT        MaxTf;
+     NUMPTRS          Num;
+     NUMPTRS          Pos;        /* the one under the cursor, from 0
+                                     to Num */
+};
+
+/* New postings of one word, for its record (see InsertTree.c): Num
+   documents, in increasing order, after those the record has */
+struct PostBatch {
+     NUMPTRS          Num;
+     DOCID           *Docs;
+     POSTCOUNT       *Tfs;        /* the frequencies of the word in them */
+     POSTCOUNT       *Where;      /* with POSITIONS, its positions: Tfs[i]
+                                     of them for Docs[i] */
+};
+
+/* The words of a text, for indexing (see tokenize.c) */
+struct TokStream {
+     char            *Buf;        /* the text, mapped or read in, and an
+                                     EOS after it */
+     long             Len;        /* its bytes */
+     long             Pos;        /* the next one to look at */
+     char             Held;       /* the byte at Pos, which may hold the
+                                     EOS after the last word */
+     int              Mapped;     /* Buf is mmap()ed, not malloc()ed */
+};
+
+/* The distinct words of a document, and their occurrences (see
+   hashtab.c); the words are numbered in the order they came */
+struct HashWord {
+     char            *Key;
+     long             Word;       /* its number */
+};
+
+struct HashTab {
+     long            *Slots;      /* open addressing: a word, or -1 */
+     long             Size;       /* slots, a power of 2 */
+     long             Num, Max;   /* words, and room for them */
+     long            *KeyOff;     /* each word's offset in Keys */
+     unsigned long   *Hash;       /* ... its hash */
+     long            *Slot;       /* ... its slot */
+     int             *Count;      /* ... and its occurrences */
+     char            *Keys;       /* the words, one after the other */
+     long             KeysUsed, KeysMax;
+     long            *OccWord;    /* with POSITIONS, the word of each */
+     POSTCOUNT       *OccPos;     /* occurrence, and its position */
+     long             NumOcc, MaxOcc;
+     struct HashWord *Order;      /* the words, sorted, for hgetnext() */
+     long            *Start;      /* ... and their positions in Where */
+     POSTCOUNT       *Where;
+     long             Next;       /* the next one hgetnext() gives, or -1 */
+     long             Last;       /* the one it gave last, or -1 */
+};
+
+/* A document on its way to the index, in the pipeline of ingest.c */
+struct IngSlot {
+     long             Turn;       /* the document that may go in next */
+     int              Ready;      /* it holds the document Turn */
+     int              Failed;     /* ... which could not be read */
+     char            *Text;       /* its text, as it was read */
+     long             Len, Max;   /* its bytes, and room for them */
+     struct HashTab   Tab;        /* its words */
+};
+
+#define MAXQUERYSIZE	(1024)	/* longest query line (see query.c) */
 
 #define gotoeof(x)	fseek((x), (long) 0, 2);
 
+/* Layout of a page image on disk (slotted page; see slotpage.c) */
+#define SP_TYPE		(0)	/* PgTypeID */
+#define SP_NKEYS	(2)	/* number of keys */
+#define SP_HEAP		(4)	/* start of the key heap (nonleaf), or end of
+				   the entries (leaf) */
+#define SP_PGNUM	(8)	/* page number */
+#define SP_LINK		(16)	/* next leaf, or rightmost child */
+#define SP_SLOTS	(24)	/* the slot array, or the leaf entries */
+#define IsLeafImage(p)     (LeafSymbol == (p)[SP_TYPE])
+#define IsNonLeafImage(p)  (NonLeafSymbol == (p)[SP_TYPE])
+/* bytes taken by a key of length 'len': slot, pointer, length, key */
+#define SlotSize(len)	(sizeof(SLOT) + sizeof(POSTINGSPTR) + 1 + (len))
+/* leaves front-code their keys, storing one key in full every LEAFRESTART */
+#define LEAFRESTART	(8)
+/* bytes of a leaf entry with a suffix of length 'len': pointer, number
+   of bytes shared with the previous key, suffix length, suffix */
+#define LeafEntrySize(len)	(sizeof(POSTINGSPTR) + 2 + (len))
+
 /* The following structure is utilized for holding a page of the B-Tree.
    It is used for both Leaf and NonLeaf pages.  The pages are differentiated
    by the first byte which contains 'L' if it is a Leaf page or 'N' if it
@@ -60,6 +224,8 @@ struct PageHdr {
      NUMKEYS           NumKeys;          
      struct KeyRecord *KeyListPtr;
      PAGENO           PtrToFinalRtgPg;  /* FOR NONLEAF PAGES ONLY */ 
+     int              PinnedFrame;      /* buffer-pool frame pinned by
+                                           FetchPage(), or NOFRAME */
 };
 
 
@@ -80,6 +246,19 @@ struct KeyRecord {
      struct KeyRecord *Next;
 };
 
+/* A path from the root to a leaf, as found by TreeDescend() (see
+   treepath.c).  Level 0 is the root. */
+#define MAXHEIGHT	(64)
+
+struct TreePath {
+	int		Depth;		/* number of levels on the path */
+	PAGENO		PgNum[MAXHEIGHT];
+	int		Pos[MAXHEIGHT];	/* child taken (nonleaf), or key
+					   position (leaf), at each level */
+	int		Found;		/* TRUE if the leaf holds the key */
+	int		Frame;		/* the leaf, pinned */
+};
+
 /* 'upKey' should be used to hold the key to be moved upwards
     upon splitting */
 struct upKey {
@@ -0,0 +1,168 @@
+/* doctable.c */
+
+/*  The table of the documents, in DOCTABLE.  The postings name the
+    documents by number (DOCID, see postrec.c), from 0, in the order
+    they were added; the table maps each number to
+        Start       the offset of the document in TEXTFILE, at its TAG
+        Size        its bytes in TEXTFILE, the TAG left out, so that it
+                    is printed without looking for the next TAG
+        Len         its length, for ranking (see rank.c): the number of
+                    its words that are indexed - common words left out,
+                    repeated words counted every time
+        Name        the file it came from
+    The file holds these fields one after the other, for each document
+    in order, the name as an int length followed by its bytes.
+
+    DocOpen() reads the whole table into memory (but the names) when
+    the database is opened, and DocAdd() appends each new document to
+    both; a document is found by indexing the arrays with its number.
+*/
+
+#include "def.h"
+
+FILE *fpdoctable;
+
+extern FILE *fptext;
+extern void pr_msg(long int start, long int size, FILE *fp);
+
+static TEXTPTR *Starts = NULL; /* the offsets of the documents */
+static long *Sizes = NULL;     /* ... their bytes */
+static long *Lens = NULL;      /* ... and their lengths */
+static long NumDocs, MaxDocs;
+static double TotalLen;
+
+static void DocGrow(void) {
+    MaxDocs = max(2 * MaxDocs, 1024);
+    Starts = (TEXTPTR *) realloc(Starts, sizeof(TEXTPTR) * MaxDocs);
+    Sizes = (long *) realloc(Sizes, sizeof(long) * MaxDocs);
+    Lens = (long *) realloc(Lens, sizeof(long) * MaxDocs);
+    ck_malloc(Starts, "Starts in DocGrow()");
+    ck_malloc(Sizes, "Sizes in DocGrow()");
+    ck_malloc(Lens, "Lens in DocGrow()");
+}
+
+/* opens, or creates, DOCTABLE, and reads it in */
+void DocOpen(void) {
+    TEXTPTR start;
+    long size, len;
+    int namelen;
+
+    NumDocs = MaxDocs = 0;
+    TotalLen = 0;
+    if ((fpdoctable = fopen("DOCTABLE", "r+")) == NULL) {
+        printf("Creating document table...\n");
+        fpdoctable = fopen("DOCTABLE", "w+");
+        ck_file(fpdoctable, "DOCTABLE");
+        return;
+    }
+    while ((fread(&start, sizeof(start), 1, fpdoctable) == 1) &&
+           (fread(&size, sizeof(size), 1, fpdoctable) == 1) &&
+           (fread(&len, sizeof(len), 1, fpdoctable) == 1) &&
+           (fread(&namelen, sizeof(namelen), 1, fpdoctable) == 1)) {
+        fseek(fpdoctable, (long) namelen, 1);
+        if (NumDocs == MaxDocs)
+            DocGrow();
+        Starts[NumDocs] = start;
+        Sizes[NumDocs] = size;
+        Lens[NumDocs++] = len;
+        TotalLen += len;
+    }
+}
+
+/* reads the names of the documents from DOCTABLE, which must not be
+   open, with their offsets, in *pStarts; returns the names, *pNum of
+   them, none if there is no DOCTABLE; the caller frees them */
+char **DocNames(TEXTPTR **pStarts, long *pNum) {
+    char **names = NULL;
+    TEXTPTR start;
+    long size, len, n = 0, maxnames = 0;
+    int namelen;
+    FILE *fp;
+
+    *pStarts = NULL;
+    *pNum = 0;
+    if ((fp = fopen("DOCTABLE", "r")) == NULL)
+        return (NULL);
+    while ((fread(&start, sizeof(start), 1, fp) == 1) &&
+           (fread(&size, sizeof(size), 1, fp) == 1) &&
+           (fread(&len, sizeof(len), 1, fp) == 1) &&
+           (fread(&namelen, sizeof(namelen), 1, fp) == 1) &&
+           (namelen >= 0)) {
+        if (n == maxnames) {
+            maxnames = max(2 * maxnames, 1024);
+            names = (char **) realloc(names, sizeof(char *) * maxnames);
+            *pStarts = (TEXTPTR *) realloc(*pStarts,
+                                           sizeof(TEXTPTR) * maxnames);
+            ck_malloc(names, "names in DocNames()");
+            ck_malloc(*pStarts, "*pStarts in DocNames()");
+        }
+        names[n] = (char *) malloc(namelen + 1);
+        ck_malloc(names[n], "names[] in DocNames()");
+        if (fread(names[n], 1, namelen, fp) != (size_t) namelen) {
+            free(names[n]);
+            break;
+        }
+        names[n][namelen] = EOS;
+        (*pStarts)[n++] = start;
+    }
+    fclose(fp);
+    *pNum = n;
+    return (names);
+}
+
+/* records the document of 'Size' bytes at 'Start', which must follow
+   all the documents recorded so far, with its length 'Len' and the
+   name of its file; returns its number, which was DocCount() */
+DOCID DocAdd(TEXTPTR Start, long Size, long Len, char *Name) {
+    int namelen = strlen(Name);
+
+    assert((NumDocs == 0) || (Start > Starts[NumDocs - 1]));
+    assert(NumDocs < ENDOFLIST);
+    if (NumDocs == MaxDocs)
+        DocGrow();
+    Starts[NumDocs] = Start;
+    Sizes[NumDocs] = Size;
+    Lens[NumDocs++] = Len;
+    TotalLen += Len;
+
+    gotoeof(fpdoctable);
+    fwrite(&Start, sizeof(Start), 1, fpdoctable);
+    fwrite(&Size, sizeof(Size), 1, fpdoctable);
+    fwrite(&Len, sizeof(Len), 1, fpdoctable);
+    fwrite(&namelen, sizeof(namelen), 1, fpdoctable);
+    fwrite(Name, 1, namelen, fpdoctable);
+    return ((DOCID) (NumDocs - 1));
+}
+
+/* the length of the document 'Doc' */
+long DocLen(DOCID Doc) {
+    assert((Doc >= 0) && (Doc < NumDocs));
+    return (Lens[Doc]);
+}
+
+/* prints the text of the document 'Doc' */
+void DocPrint(DOCID Doc) {
+    assert((Doc >= 0) && (Doc < NumDocs));
+    pr_msg(Starts[Doc], Sizes[Doc], fptext);
+}
+
+/* the number of documents */
+long DocCount(void) {
+    return (NumDocs);
+}
+
+/* the average length of the documents */
+double DocAvgLen(void) {
+    return ((NumDocs > 0) ? TotalLen / NumDocs : 0.0);
+}
+
+void DocClose(void) {
+    fclose(fpdoctable);
+    free(Starts);
+    free(Sizes);
+    free(Lens);
+    Starts = NULL;
+    Sizes = NULL;
+    Lens = NULL;
+    NumDocs = MaxDocs = 0;
+}
@@ -1,27 +1,37 @@
 /* calculates the number of bytes and number of keys
    for a given
         PagePtr		page image
-   and fills in the appropriate fields in the structure
+   and fills in the appropriate fields in the structure.
+   The byte count is the size of the page in the layout of
+   slotpage.c; in a leaf, it depends on the prefix each key
+   shares with the key before it.
  */
 
 #include "def.h"
 
+extern int SlotLeafBytes(int i, char *Prev, int PrevLen, char *Key,
+                         int KeyLen);
+
 void fillIn(struct PageHdr *PagePtr)
 /* Pointer to page being filled-in */
 {
-    struct KeyRecord *p;
+    struct KeyRecord *p, *prev = NULL;
     NUMBYTES bytes;
     NUMKEYS keys;
 
-    bytes = sizeof(PagePtr->PgTypeID) + sizeof(PagePtr->PgNum) +
-            sizeof(PagePtr->PgNumOfNxtLfPg) + sizeof(PagePtr->NumBytes) +
-            sizeof(PagePtr->NumKeys);
+    bytes = SP_SLOTS;
 
     keys = 0;
 
-    for (p = PagePtr->KeyListPtr; p != NULL; p = p->Next) {
+    for (p = PagePtr->KeyListPtr; p != NULL; prev = p, p = p->Next) {
+        if (!IsLeaf(PagePtr))
+            bytes += SlotSize(p->KeyLen);
+        else if (prev == NULL)
+            bytes += SlotLeafBytes(keys, NULL, 0, p->StoredKey, p->KeyLen);
+        else
+            bytes += SlotLeafBytes(keys, prev->StoredKey, prev->KeyLen,
+                                   p->StoredKey, p->KeyLen);
         keys++;
-        bytes += p->KeyLen + sizeof(POSTINGSPTR) + sizeof(KEYLEN);
     }
 
     PagePtr->NumBytes = bytes;
@@ -0,0 +1,55 @@
+/* freelist.c */
+
+/*  The free lists of POSTINGSFILE.
+
+    Postings records come in NUMLISTS size classes: class i holds up to
+    LISTSIZE[i] bytes of postings (see setparms.c).  The freed records of
+    each class are chained through their first word, and the heads of
+    the NUMLISTS chains are the first NUMLISTS words of the file.
+
+    The heads are read once, by dbopen(), and kept in FreeHead[] while
+    the index is open; getrec() and freerec() work on them in memory,
+    and dbsync() writes them back, at the end of every command.
+*/
+
+#include <math.h>
+#include "def.h"
+
+extern FILE *fppost;
+extern long LISTSIZE[NUMLISTS];
+extern double GF;
+
+POSTINGSPTR FreeHead[NUMLISTS]; /* (-1) for an empty list */
+
+/* reads the heads of the free lists */
+void FreeRead(void) {
+    fseek(fppost, (long) 0, 0);
+    if (fread(FreeHead, sizeof(POSTINGSPTR), NUMLISTS, fppost) != NUMLISTS) {
+        printf("POSTINGSFILE is too short - remove it to start over\n");
+        exit(-1);
+    }
+}
+
+/* writes back the heads of the free lists */
+void FreeWrite(void) {
+    fseek(fppost, (long) 0, 0);
+    fwrite(FreeHead, sizeof(POSTINGSPTR), NUMLISTS, fppost);
+}
+
+/* the smallest size class whose records hold 'size' bytes of postings.
+   LISTSIZE[i] is about GF^i, so the logarithm is within a class or
+   two of the answer; the loops only correct the rounding. */
+int SizeClass(long size) {
+    int i;
+
+    if (size <= 1)
+        return (0);
+    i = (int) (log((double) size) / log(GF));
+    if (i >= NUMLISTS)
+        i = NUMLISTS - 1;
+    while ((i < NUMLISTS - 1) && (LISTSIZE[i] < size))
+        i++;
+    while ((i > 0) && (LISTSIZE[i - 1] >= size))
+        i--;
+    return (i);
+}
@@ -4,12 +4,10 @@
  */
 
 #include "def.h"
-extern FILE *fpbtree;
 
 PAGENO getNewPageNum(void) {
     PAGENO new;
-    long ffsize(FILE * fp);
 
-    new = (PAGENO) ffsize(fpbtree) / PAGESIZE + 1;
+    new = ++SuperBlk.NumPages; /* counted in the superblock */
     return (new);
 }
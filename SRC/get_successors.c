@@ -4,6 +4,9 @@
  * The key is not included in the result. 
  * If there are less than k successors, the result should
  * still return them. 
+ * The key itself must be in the tree.
+ * The leaves are reached along the chain of leaves, starting
+ * at the leaf of the key.
  *
  * Author: Xiaoxiang Wu
  * Andrew ID: xiaoxiaw
@@ -13,36 +16,18 @@
 extern int iscommon(char *word);
 extern int check_word(char *word);
 extern int strtolow(char *s);
-extern PAGENO treesearch_page(PAGENO pageNo, char *key);
-extern int FreePage(struct PageHdr *PagePtr);
-extern struct PageHdr *FetchPage(PAGENO Page);
-extern int FindInsertionPosition(struct KeyRecord *KeyListTraverser, char *Key, 
-        int *Found, NUMKEYS NumKeys, int Count);
-extern PAGENO FindNumPagesInTree(void);
-
-struct KeyRecord* findKey(struct PageHdr* PagePtr, char *key) {
-    struct KeyRecord *KeyListTraverser;
-    int i, pos, found, count = 0; 
-
-    KeyListTraverser = PagePtr->KeyListPtr;
-    pos = FindInsertionPosition(KeyListTraverser, 
-            key, &found, PagePtr->NumKeys, count);
-    for (i = 0; i < pos - 1; ++i) {
-        KeyListTraverser = KeyListTraverser->Next;
-    }
-    return KeyListTraverser;
-
-    /*
-    if (found == TRUE) {
-        return KeyListTraverser;
-    } else {  // cannot find the key in the page
-        return NULL;
-    }
-    */
-}
+extern char *TreeDescend(PAGENO Root, char *Key, struct TreePath *Path);
+extern char *PinPage(PAGENO Page, int *pFrame);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotNumKeys(char *Page);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern PAGENO SlotLink(char *Page);
 
 int get_successors(char *key, int k) {
-    struct KeyRecord *KeyListTraverser;
+    struct TreePath Path;
+    char *Page, *Word;
+    int pos, i, j, len;
+    PAGENO next;
 
     // check parameters first
     if (k <= 0) {
@@ -65,47 +50,45 @@ int get_successors(char *key, int k) {
     /* turn to lower case, for uniformity */
     strtolow(key);
 
-    /* recursive call to find page number */
-    const PAGENO page = treesearch_page(ROOT, key);
-    /* from page number we traverse the leaf page */
-    struct PageHdr *PagePtr = FetchPage(page);
-    // get the key pointer from the page
-    KeyListTraverser = findKey(PagePtr, key);
+    /* find the leaf of the key; it comes back pinned */
+    Page = TreeDescend(ROOT, key, &Path);
+    if (!Path.Found) {
+        printf("key: \"%s\": not found\n", key);
+        BufUnpin(Path.Frame, FALSE);
+        return -1;
+    }
+    pos = Path.Pos[Path.Depth - 1];
 
     char** result = (char**)calloc(k, sizeof(char*));
-    int i;
-    struct PageHdr* nextPagePtr = NULL;
-    // remember to check if k execeed remaining key nums
+    // walk to the right, along the chain of leaves
     for (i = 0; i < k; ++i) {
-        KeyListTraverser = KeyListTraverser->Next;
-        if (KeyListTraverser == NULL) {  // end of this page
-            // try to fetch next leaf page
-            PAGENO page = PagePtr->PgNumOfNxtLfPg;
-            if (page < 1 || page > FindNumPagesInTree()) {
+        while (++pos >= SlotNumKeys(Page)) {  // end of this page
+            next = SlotLink(Page);
+            BufUnpin(Path.Frame, FALSE);
+            if (next == NULLPAGENO) {  // that was the last leaf
+                Path.Frame = NOFRAME;
                 break;
             }
-            nextPagePtr = FetchPage(PagePtr->PgNumOfNxtLfPg);
-            KeyListTraverser = nextPagePtr->KeyListPtr;
-            FreePage(PagePtr);  // free space
-            PagePtr = nextPagePtr;
+            Page = PinPage(next, &Path.Frame);
+            pos = -1;
         }
-        result[i] = (char*)malloc((KeyListTraverser->KeyLen + 1) * sizeof(char));
-        strcpy(result[i], KeyListTraverser->StoredKey);
+        if (Path.Frame == NOFRAME)
+            break;
+        Word = SlotKey(Page, pos, &len);
+        result[i] = (char*)malloc((len + 1) * sizeof(char));
+        memcpy(result[i], Word, len);
+        result[i][len] = '\0';
     }
+    if (Path.Frame != NOFRAME)
+        BufUnpin(Path.Frame, FALSE);
 
     // print out the result
     printf("found %d successors:\n", i);
-    int j;
     for (j = 0; j < i; ++j) {
         printf("%s\n", result[j]);
         free(result[j]);
     }
     free(result);
 
-    // free space
-    if (nextPagePtr != NULL) {
-        free(nextPagePtr);
-    }
-
     return 0;
 }
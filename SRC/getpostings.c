@@ -3,39 +3,42 @@
 /* Modified by Frank Andrasco
 
 ****************************************************************************
-This function retrieves all the textfile pointers from the postings file
-starting at the postingsfile offset passed in pptr.  This routine always
+This function retrieves all the documents from the postings file
+starting at the postingsfile offset passed in pptr, and prints them,
+through the document table (see doctable.c).  This routine always
 requires only one disk read, since all postings pointers are stored
-contiguously.
+contiguously, delta-coded (see postrec.c).
 
 ****************************************************************************/
 
 #include "def.h"
-extern FILE *fppost;
-extern FILE *fptext; /* to be deleted, -christos- */
 
-extern int pReadCount;
-
-extern void pr_msg(long int start, FILE *fp);
+extern void DocPrint(DOCID Doc);
+extern DOCID PostDecode(unsigned char *Buf, NUMPTRS Num, DOCID *Docs,
+                        POSTCOUNT *Tfs, POSTCOUNT *Where);
+extern unsigned char *PostRead(POSTINGSPTR pptr, struct PostHdr *Hdr);
 
 void getpostings(POSTINGSPTR pptr) {
 
-    NUMPTRS NumTextOffsets;
-    TEXTPTR TextOffset;
+    struct PostHdr hdr;
+    unsigned char *buf;
+    DOCID *Docs;
     int i;
     int docCount; /* counter, for the qualifying documents */
 
     docCount = 0;
-    pReadCount++; /* counts disk reads */
-    fseek(fppost, (long) pptr, 0);
-    fread(&NumTextOffsets, sizeof(NumTextOffsets), 1, fppost);
-
-    for (i = 0; i < NumTextOffsets; i++) {
-        fread(&TextOffset, sizeof(TextOffset), 1, fppost);
-        /* printf (" %d", TextOffset); */
+    buf = PostRead(pptr, &hdr); /* counts the disk read */
+    Docs = (DOCID *) malloc(sizeof(DOCID) * (hdr.NumPtrs + 1));
+    ck_malloc(Docs, "Docs");
+    PostDecode(buf, hdr.NumPtrs, Docs, NULL, NULL);
+    free(buf);
+
+    for (i = 0; i < hdr.NumPtrs; i++) {
+        /* printf (" %d", Docs[i]); */
         printf("-------document #%d-----\n", ++docCount);
-        pr_msg(TextOffset, fptext);
+        DocPrint(Docs[i]);
     }
+    free(Docs);
 
     printf("\n");
 }
@@ -1,142 +1,255 @@
 /* This file contains routines that manage a hash table
-   with separate chaining
-   Much of the code is from the C book, p. 135
+   with open addressing, for the distinct words of a document.
+   Each word keeps the number of times it was inserted, which is its
+   term frequency in the document being indexed, and, with POSITIONS,
+   the positions it was inserted at.
+
+   The table (struct HashTab, in def.h) holds the numbers of the words,
+   in the order they came, and is probed linearly from the hash of the
+   word; it doubles when it gets half full.  The words themselves go
+   one after the other in Keys, and their counts and hashes in arrays
+   indexed by their numbers; the occurrences are noted in the order
+   they came, and sorted out by word only when the positions are asked
+   for.  hfree() empties the table for the next document but keeps
+   its memory, so a long run of documents allocates nothing once the
+   table has grown to the longest of them.
+
+   hgetnext() gives the words in alphabetical order, so that the
+   insertions that follow walk the B-tree from left to right.  Nothing
+   here is shared between tables, so separate threads may fill
+   separate tables (see ingest.c).
  */
 
-#include <strings.h>
-#include <string.h>
-#include <stdlib.h>
 #include "def.h"
-#define HASHSIZE 100
-
-struct nlist {/* basic table entry */
-    char *key;
-    struct nlist *next;
-};
-static struct nlist *hashtab[HASHSIZE];
-
-/* inserts a word in the hash table */
-
-int hash(char *word);
-
-void inhash(char *word) {
-    struct nlist *np;
-    /* char *malloc(); */
-    int val;
-
-    val = hash(word);
-    np = hashtab[val];
-    while ((np != NULL)) {
-        if (strcmp(np->key, word) == 0) { /* found */
-            return;                       /* do nothing */
-        } else {
-            np = np->next;
-        }
+
+#define HASHMINSIZE (256) /* slots of the table, at first */
+#define HASHMUL (0x9e3779b97f4a7c15ULL)
+
+/* hashing function: a word at a time, and a final mix of the bits */
+static unsigned long hash(char *word, long *pLen) {
+    unsigned long long h = HASHMUL, v;
+    long len = strlen(word), i;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        memcpy(&v, word + i, 8);
+        h = (h ^ v) * HASHMUL;
+        h ^= h >> 29;
     }
+    v = 0;
+    memcpy(&v, word + i, len - i);
+    h = (h ^ v ^ (unsigned long long) len) * HASHMUL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    *pLen = len;
+    return ((unsigned long) h);
+}
+
+/* the slot the probing for the hash 'h' starts from */
+#define FirstSlot(H, h) ((long) ((h) & ((H)->Size - 1)))
 
-    /* if this line is reached, the word has not been found;
-       insert it at the beginning of the chain */
-    np = (struct nlist *) malloc(sizeof(struct nlist));
-    ck_malloc(np, "np in inhash()");
+static void *hgrow(void *p, long n, size_t size, char *name) {
+    p = realloc(p, n * size);
+    ck_malloc(p, name);
+    return (p);
+}
 
-    np->key = malloc(strlen(word) + 1);
-    strcpy(np->key, word);
-    ck_malloc(np->key, "np->key in inhash()");
-    np->next = hashtab[val];
-    hashtab[val] = np;
+void inithash(struct HashTab *H) {
+    long i;
+
+    H->Size = HASHMINSIZE;
+    H->Slots = (long *) malloc(sizeof(long) * H->Size);
+    ck_malloc(H->Slots, "H->Slots in inithash()");
+    for (i = 0; i < H->Size; i++)
+        H->Slots[i] = -1;
+    H->Num = H->Max = 0;
+    H->KeyOff = H->Slot = H->Start = NULL;
+    H->Hash = NULL;
+    H->Count = NULL;
+    H->Order = NULL;
+    H->Keys = NULL;
+    H->KeysUsed = H->KeysMax = 0;
+    H->OccWord = NULL;
+    H->OccPos = H->Where = NULL;
+    H->NumOcc = H->MaxOcc = 0;
+    H->Next = H->Last = -1;
 }
 
-/* gives the next word in the hash table,
-   returning EOH if that's the end */
-static int position = -1;
-static struct nlist *np = (struct nlist *) NULL; /* np runs over all the
- nodes */
-int hgetnext(char *word) {
-    if (np != (struct nlist *) NULL) {
-        strcpy((char *) word, (char *) (np->key));
-        np = np->next;
-        return (TRUE);
-    } else {
-        position++; /* examine next slot */
-        /* skip empty slots */
-        while ((hashtab[position] == NULL) && (position < HASHSIZE)) {
-            position++;
-        }
-
-        if (position == HASHSIZE) {
-            position = -1; /* reset for the future */
-            np = NULL;
-            return (EOH);
-        } else {
-            np = hashtab[position];
-            strcpy((char *) word, np->key);
-            np = np->next;
-            return (TRUE);
-        }
+/* doubles the table, and puts the words back in */
+static void hresize(struct HashTab *H) {
+    long i, s;
+
+    H->Size *= 2;
+    H->Slots = (long *) hgrow(H->Slots, H->Size, sizeof(long),
+                              "H->Slots in hresize()");
+    for (i = 0; i < H->Size; i++)
+        H->Slots[i] = -1;
+    for (i = 0; i < H->Num; i++) {
+        for (s = FirstSlot(H, H->Hash[i]); H->Slots[s] != -1;
+             s = (s + 1) & (H->Size - 1))
+            ;
+        H->Slots[s] = i;
+        H->Slot[i] = s;
     }
 }
 
-void inithash(void) {
-    int i;
+/* a new word, numbered H->Num, with the hash 'h', in the slot 's' */
+static void hnew(struct HashTab *H, char *word, long len, unsigned long h,
+                 long s) {
+    long n = H->Num;
+
+    if (n == H->Max) {
+        H->Max = max(2 * H->Max, 128);
+        H->KeyOff = (long *) hgrow(H->KeyOff, H->Max, sizeof(long),
+                                   "H->KeyOff in inhash()");
+        H->Hash = (unsigned long *) hgrow(H->Hash, H->Max,
+                                          sizeof(unsigned long),
+                                          "H->Hash in inhash()");
+        H->Slot = (long *) hgrow(H->Slot, H->Max, sizeof(long),
+                                 "H->Slot in inhash()");
+        H->Count = (int *) hgrow(H->Count, H->Max, sizeof(int),
+                                 "H->Count in inhash()");
+        H->Start = (long *) hgrow(H->Start, H->Max, sizeof(long),
+                                  "H->Start in inhash()");
+        H->Order = (struct HashWord *) hgrow(H->Order, H->Max,
+                                             sizeof(struct HashWord),
+                                             "H->Order in inhash()");
+    }
+    if (H->KeysUsed + len + 1 > H->KeysMax) {
+        H->KeysMax = max(2 * H->KeysMax, H->KeysUsed + len + 4096);
+        H->Keys = (char *) hgrow(H->Keys, H->KeysMax, 1,
+                                 "H->Keys in inhash()");
+    }
+    memcpy(H->Keys + H->KeysUsed, word, len + 1);
+    H->KeyOff[n] = H->KeysUsed;
+    H->KeysUsed += len + 1;
+    H->Hash[n] = h;
+    H->Slot[n] = s;
+    H->Count[n] = 0;
+    H->Slots[s] = n;
+    H->Num++;
+}
 
-    for (i = 0; i < HASHSIZE; i++) {
-        hashtab[i] = NULL;
+/* inserts a word in the hash table, found at position 'pos' of the
+   document */
+void inhash(struct HashTab *H, char *word, POSTCOUNT pos) {
+    unsigned long h;
+    long len, s, n;
+
+    if (2 * (H->Num + 1) > H->Size)
+        hresize(H);
+    h = hash(word, &len);
+    for (s = FirstSlot(H, h); (n = H->Slots[s]) != -1;
+         s = (s + 1) & (H->Size - 1))
+        if ((H->Hash[n] == h) && (strcmp(H->Keys + H->KeyOff[n], word) == 0))
+            break;
+    if (n == -1) { /* not found: a new word */
+        n = H->Num;
+        hnew(H, word, len, h, s);
     }
+    H->Count[n]++;
+
+    if (!POSITIONS)
+        return;
+    if (H->NumOcc == H->MaxOcc) {
+        H->MaxOcc = max(2 * H->MaxOcc, 1024);
+        H->OccWord = (long *) hgrow(H->OccWord, H->MaxOcc, sizeof(long),
+                                    "H->OccWord in inhash()");
+        H->OccPos = (POSTCOUNT *) hgrow(H->OccPos, H->MaxOcc,
+                                        sizeof(POSTCOUNT),
+                                        "H->OccPos in inhash()");
+        H->Where = (POSTCOUNT *) hgrow(H->Where, H->MaxOcc,
+                                       sizeof(POSTCOUNT),
+                                       "H->Where in inhash()");
+    }
+    H->OccWord[H->NumOcc] = n;
+    H->OccPos[H->NumOcc++] = pos;
+}
+
+static int hcmp(const void *a, const void *b) {
+    return (strcmp(((struct HashWord *) a)->Key,
+                   ((struct HashWord *) b)->Key));
 }
 
-void hprint(void) { /* prints the hash table, for debugging */
-    int i;
-    struct nlist *np;
-
-    for (i = 0; i < HASHSIZE; i++) {
-        if ((np = hashtab[i]) != NULL) {
-            printf("slot %d: ", i);
-            for (; np != NULL; np = np->next) {
-                printf("%s ", np->key);
-            }
-            printf("\n");
-        }
+/* sorts the words, and groups the positions of each word, for
+   hgetnext(), which does it itself if need be */
+void hsort(struct HashTab *H) {
+    long i, at;
+
+    H->Next = 0;
+    for (i = 0; i < H->Num; i++) {
+        H->Order[i].Key = H->Keys + H->KeyOff[i];
+        H->Order[i].Word = i;
+    }
+    qsort(H->Order, H->Num, sizeof(struct HashWord), hcmp);
+    if (!POSITIONS)
+        return;
+    for (at = 0, i = 0; i < H->Num; i++) {
+        H->Start[i] = at;
+        at += H->Count[i];
     }
+    for (i = 0; i < H->NumOcc; i++)
+        H->Where[H->Start[H->OccWord[i]]++] = H->OccPos[i];
+    for (i = 0; i < H->Num; i++) /* back to the first position */
+        H->Start[i] -= H->Count[i];
 }
 
-/* frees the space of the hash table */
-void hfree(void) {
-    int i;
-    struct nlist *np, *npnext;
-
-    for (i = 0; i < HASHSIZE; i++) {
-        if ((np = hashtab[i]) != NULL) {
-#ifdef DEBUG
-            printf("freeing slot %d: ", i);
-#endif
-
-            while (np != NULL) {
-#ifdef DEBUG
-                printf(" %s ", np->key);
-#endif
-
-                free((char *) np->key);
-
-                npnext = np->next;
-                free((char *) np);
-                np = npnext;
-            }
-            hashtab[i] = NULL; /* reset it, for the future */
-#ifdef DEBUG
-
-            printf("\n");
-#endif
-        }
+/* gives in *word the next word in the hash table, in alphabetical
+   order, returning the number of times it was inserted, or EOH if
+   that's the end.  The word stays in the table until hfree(). */
+int hgetnext(struct HashTab *H, char **word) {
+    if (H->Next == -1)
+        hsort(H);
+    if (H->Next == H->Num) {
+        H->Next = H->Last = -1; /* reset for the future */
+        return (EOH);
     }
+    H->Last = H->Order[H->Next++].Word;
+    *word = H->Keys + H->KeyOff[H->Last];
+    return (H->Count[H->Last]);
 }
 
-/* hashing function */
-int hash(char *word) {
-    int val;
-    int i;
+/* the positions of the word that hgetnext() gave last, in increasing
+   order, or NULL without POSITIONS */
+POSTCOUNT *hpositions(struct HashTab *H) {
+    if (!POSITIONS || (H->Last == -1))
+        return (NULL);
+    return (H->Where + H->Start[H->Last]);
+}
 
-    for (val = 0, i = 0; word[i] != '\0'; i++) {
-        val += word[i];
-    }
-    return (val % HASHSIZE);
+void hprint(struct HashTab *H) { /* prints the hash table, for debugging */
+    long i;
+
+    for (i = 0; i < H->Num; i++)
+        printf("slot %ld: %s %d\n", H->Slot[i], H->Keys + H->KeyOff[i],
+               H->Count[i]);
+}
+
+/* empties the hash table, for the next document, keeping its space */
+void hfree(struct HashTab *H) {
+    long i;
+
+    for (i = 0; i < H->Num; i++)
+        H->Slots[H->Slot[i]] = -1;
+    H->Num = 0;
+    H->KeysUsed = 0;
+    H->NumOcc = 0;
+    H->Next = H->Last = -1;
+}
+
+/* frees the space of the hash table */
+void hclose(struct HashTab *H) {
+    free(H->Slots);
+    free(H->KeyOff);
+    free(H->Hash);
+    free(H->Slot);
+    free(H->Count);
+    free(H->Start);
+    free(H->Order);
+    free(H->Keys);
+    free(H->OccWord);
+    free(H->OccPos);
+    free(H->Where);
+    H->Slots = NULL;
+    H->Num = H->Max = H->KeysMax = H->MaxOcc = 0;
 }
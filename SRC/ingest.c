@@ -0,0 +1,245 @@
+/* ingest.c */
+
+/*  Inserts many files at once (command "I"): the files named in a list
+    file, one name per line, or the files of a directory, in the order
+    of their names.  The database ends up exactly as after one "i" per
+    file, in the same order.
+
+    A pool of THREADS worker threads (see setparms.c) reads the files
+    and splits them into their words (TextWords(), see insert.c), each
+    file into a hash table of its own; the main thread, the only one
+    that touches the database, takes the files in order, as they get
+    ready, and appends them to TEXTFILE and their words to the index
+    (TextAppend() and TextIndex()), as insert() does.
+
+    The files in flight go through a ring of ING_SLOTS slots per thread:
+    the file numbered i takes the slot i % NumSlots, once the main
+    thread is done with the file i - NumSlots, so a slow file holds up
+    the workers only when they get that many files ahead of it.  Each
+    slot keeps its hash table, and the room for the text, from one file
+    to the next.
+
+    IngRun() is the pipeline, for any documents: buildIndex() (command
+    "r") runs the documents of TEXTFILE through it.
+*/
+
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "def.h"
+
+#define ING_SLOTS (4) /* slots per worker thread */
+
+extern void sort_string_array(char **arr, size_t n);
+extern void TokInit(void);
+extern void TokOpen(struct TokStream *T, FILE *fp);
+extern void TokClose(struct TokStream *T);
+extern void inithash(struct HashTab *H);
+extern void hsort(struct HashTab *H);
+extern void hfree(struct HashTab *H);
+extern void hclose(struct HashTab *H);
+extern TEXTPTR TextAppend(char *Text, long Len);
+extern void TextWords(struct TokStream *T, struct HashTab *H);
+extern void TextIndex(TEXTPTR Start, long Size, char *fname,
+                      struct HashTab *H);
+
+static char **Names; /* the files */
+static long NumNames;
+static long NumItems; /* the documents in the pipeline */
+static struct IngSlot *Slots;
+static long NumSlots;
+static long NextItem; /* the next document for a worker */
+static void (*ReadItem)(long i, struct IngSlot *S);
+static pthread_mutex_t Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Filled = PTHREAD_COND_INITIALIZER; /* a slot */
+static pthread_cond_t Emptied = PTHREAD_COND_INITIALIZER;
+
+/* adds a copy of 'Name' to the files */
+static void IngAddName(char *Name, long *pMax) {
+    if (NumNames == *pMax) {
+        *pMax = max(2 * *pMax, 1024);
+        Names = (char **) realloc(Names, sizeof(char *) * *pMax);
+        ck_malloc(Names, "Names in IngAddName()");
+    }
+    Names[NumNames] = (char *) malloc(strlen(Name) + 1);
+    ck_malloc(Names[NumNames], "Names[] in IngAddName()");
+    strcpy(Names[NumNames++], Name);
+}
+
+/* the files to insert: the regular files of the directory 'Path' in the
+   order of their names, or those named in the list file 'Path' */
+static int IngNames(char *Path) {
+    char name[1024];
+    struct stat st;
+    struct dirent *e;
+    long maxnames = 0;
+    DIR *dir;
+    FILE *fp;
+
+    NumNames = 0;
+    if ((stat(Path, &st) == 0) && S_ISDIR(st.st_mode)) {
+        if ((dir = opendir(Path)) == NULL) {
+            printf("Error: Cannot Open Directory: %s\n", Path);
+            return (FALSE);
+        }
+        while ((e = readdir(dir)) != NULL) {
+            if (e->d_name[0] == '.')
+                continue;
+            snprintf(name, sizeof(name), "%s/%s", Path, e->d_name);
+            if ((stat(name, &st) == 0) && S_ISREG(st.st_mode))
+                IngAddName(name, &maxnames);
+        }
+        closedir(dir);
+        if (NumNames > 0)
+            sort_string_array(Names, NumNames);
+        return (TRUE);
+    }
+    if ((fp = fopen(Path, "r")) == NULL) {
+        printf("Error: Cannot Open List File: %s\n", Path);
+        return (FALSE);
+    }
+    while (fscanf(fp, "%1023s", name) == 1)
+        IngAddName(name, &maxnames);
+    fclose(fp);
+    return (TRUE);
+}
+
+/* reads the file 'i' into its slot, and splits it into words */
+static void IngRead(long i, struct IngSlot *S) {
+    struct TokStream tok;
+    FILE *fp;
+
+    if ((fp = fopen(Names[i], "r")) == NULL) {
+        S->Failed = TRUE;
+        return;
+    }
+    TokOpen(&tok, fp);
+    if ((S->Text == NULL) || (tok.Len > S->Max)) {
+        S->Max = max(tok.Len, 4096);
+        free(S->Text);
+        S->Text = (char *) malloc(S->Max);
+        ck_malloc(S->Text, "S->Text in IngRead()");
+    }
+    memcpy(S->Text, tok.Buf, tok.Len); /* before it turns to lower case */
+    S->Len = tok.Len;
+    TextWords(&tok, &S->Tab);
+    TokClose(&tok);
+    fclose(fp);
+}
+
+/* adds the file 'i' to TEXTFILE and to the index */
+static void IngUse(long i, struct IngSlot *S) {
+    TEXTPTR start;
+
+    if (S->Failed) {
+        printf("Error: Cannot Open Input Word File: %s\n", Names[i]);
+        return;
+    }
+    start = TextAppend(S->Text, S->Len);
+    TextIndex(start, S->Len, Names[i], &S->Tab);
+}
+
+static void *IngWorker(void *arg) {
+    struct IngSlot *s;
+    long i;
+
+    for (;;) {
+        pthread_mutex_lock(&Lock);
+        if ((i = NextItem++) >= NumItems) {
+            pthread_mutex_unlock(&Lock);
+            return (NULL);
+        }
+        s = &Slots[i % NumSlots];
+        while (s->Turn != i)
+            pthread_cond_wait(&Emptied, &Lock);
+        pthread_mutex_unlock(&Lock);
+
+        hfree(&s->Tab);
+        s->Failed = FALSE;
+        ReadItem(i, s);
+        hsort(&s->Tab);
+
+        pthread_mutex_lock(&Lock);
+        s->Ready = TRUE;
+        pthread_cond_broadcast(&Filled);
+        pthread_mutex_unlock(&Lock);
+    }
+}
+
+/* runs the documents 0 to 'Num' - 1 through the pipeline: threads
+   put each in a slot, with 'Read', in any order, and the calling thread
+   then calls 'Use' on the slots, in the order of the documents.  'Read'
+   finds the slot with an empty hash table, and sets Failed if need be.
+   Returns the number of threads. */
+long IngRun(long Num, void (*Read)(long i, struct IngSlot *S),
+            void (*Use)(long i, struct IngSlot *S)) {
+    pthread_t *workers;
+    struct IngSlot *s;
+    long i, nthreads;
+
+    nthreads = (THREADS > 0) ? THREADS : sysconf(_SC_NPROCESSORS_ONLN);
+    nthreads = max(1, min(nthreads, Num));
+    NumSlots = ING_SLOTS * nthreads;
+    Slots = (struct IngSlot *) malloc(sizeof(struct IngSlot) * NumSlots);
+    workers = (pthread_t *) malloc(sizeof(pthread_t) * nthreads);
+    ck_malloc(Slots, "Slots in IngRun()");
+    ck_malloc(workers, "workers in IngRun()");
+    for (i = 0; i < NumSlots; i++) {
+        Slots[i].Turn = i;
+        Slots[i].Ready = FALSE;
+        Slots[i].Text = NULL;
+        Slots[i].Max = 0;
+        inithash(&Slots[i].Tab);
+    }
+    NumItems = Num;
+    NextItem = 0;
+    ReadItem = Read;
+    TokInit();
+    for (i = 0; i < nthreads; i++)
+        if (pthread_create(&workers[i], NULL, IngWorker, NULL) != 0) {
+            printf("IngRun: cannot start a thread\n");
+            exit(-1);
+        }
+
+    for (i = 0; i < Num; i++) {
+        s = &Slots[i % NumSlots];
+        pthread_mutex_lock(&Lock);
+        while (!s->Ready)
+            pthread_cond_wait(&Filled, &Lock);
+        pthread_mutex_unlock(&Lock);
+
+        Use(i, s);
+
+        pthread_mutex_lock(&Lock);
+        s->Ready = FALSE;
+        s->Turn = i + NumSlots;
+        pthread_cond_broadcast(&Emptied);
+        pthread_mutex_unlock(&Lock);
+    }
+
+    for (i = 0; i < nthreads; i++)
+        pthread_join(workers[i], NULL);
+    for (i = 0; i < NumSlots; i++) {
+        free(Slots[i].Text);
+        hclose(&Slots[i].Tab);
+    }
+    free(Slots);
+    free(workers);
+    return (nthreads);
+}
+
+/* inserts the files listed in the file 'Path', or those of the
+   directory 'Path' */
+void ingest(char *Path) {
+    long i, nthreads;
+
+    if (!IngNames(Path))
+        return;
+    nthreads = IngRun(NumNames, IngRead, IngUse);
+    for (i = 0; i < NumNames; i++)
+        free(Names[i]);
+    free(Names);
+    Names = NULL;
+    printf("%ld files, %ld threads\n", NumNames, nthreads);
+}
@@ -1,5 +1,7 @@
 /* inserts the file 'fname' in the database,
-   PREFIXING it with a TAG (ctrl-V)
+   PREFIXING it with a TAG (ctrl-V).
+   The loader of many files (ingest.c) goes through the same steps:
+   TextAppend(), TextWords() and TextIndex().
  */
 
 #include <stdio.h>
@@ -9,53 +11,88 @@
 extern FILE *fpbtree, *fppost, *fptext;
 FILE *fpinp;
 
-extern int inithash(void);
+extern void inithash(struct HashTab *H);
 extern int iscommon(char *word);
-extern int strtolow(char *s);
-extern int inhash(char *word);
-extern int InsertTree(char *Key, TEXTPTR TextOffset);
-extern int hfree(void);
+extern void TokOpen(struct TokStream *T, FILE *fp);
+extern int TokNext(struct TokStream *T, char **Word, int *Upper);
+extern void TokClose(struct TokStream *T);
+extern void inhash(struct HashTab *H, char *word, POSTCOUNT pos);
+extern int hgetnext(struct HashTab *H, char **word);
+extern POSTCOUNT *hpositions(struct HashTab *H);
+extern void AccAdd(char *Word, DOCID Doc, POSTCOUNT Tf, POSTCOUNT *Where);
+extern DOCID DocAdd(TEXTPTR Start, long Size, long Len, char *Name);
+extern long DocCount(void);
+extern void hfree(struct HashTab *H);
+
+static struct HashTab tab; /* kept from one document to the next */
+
+/* appends the text 'Text' of 'Len' bytes to the file "TEXTFILE",
+   prefixed with the document separator, and returns its offset */
+TEXTPTR TextAppend(char *Text, long Len) {
+    TEXTPTR start;
+
+    gotoeof(fptext);
+    start = ftell(fptext);
+    putc(TAG, fptext);
+    fwrite(Text, 1, Len, fptext);
+    return (start);
+}
+
+/* puts the words of 'T' that are not common in the hash table 'H',
+   which counts them, and notes their positions */
+void TextWords(struct TokStream *T, struct HashTab *H) {
+    char *w; /* a word of the text (see tokenize.c) */
+    int upper;
+    POSTCOUNT pos; /* words read, common ones included */
+
+    for (pos = 0; TokNext(T, &w, &upper) != EOF; pos++) {
+        if (upper || !iscommon(w)) /* a capital: not a common word */
+            inhash(H, w, pos);
+    }
+#ifdef DEBUG
+    hprint(H); /* just for testing */
+#endif
+}
+
+/* gives the words of 'H' the next document, which is at 'Start' in
+   TEXTFILE, 'Size' bytes long, from the file 'fname' */
+void TextIndex(TEXTPTR Start, long Size, char *fname, struct HashTab *H) {
+    char *word;
+    DOCID doc = DocCount(); /* the number the document gets */
+    long len = 0;           /* words indexed, with repetitions */
+    int n;
+
+    while ((n = hgetnext(H, &word)) != EOH) {
+        AccAdd(word, doc, n, hpositions(H)); /* see accum.c */
+        len += n;
+    }
+    DocAdd(Start, Size, len, fname);
+}
 
 void insert(char *fname) {
-    char word[MAXWORDSIZE];
+    struct TokStream tok;
     TEXTPTR StartNewText; /* Offset to newly concatenated document */
-    int getword(FILE * fp, char *word), hgetnext(char *word);
-    int c;
 
     if ((fpinp = fopen(fname, "r")) == NULL) {
         printf("Error: Cannot Open Input Word File: %s\n", fname);
         return;
     }
 
-    /* Concatenate the new text file to the file "TEXTFILE"
-       and place file pointer at the start of the new text file */
-    gotoeof(fptext);
-    StartNewText = ftell(fptext);
-    putc(TAG, fptext); /* prefix with the document separator */
-    while ((c = getc(fpinp)) != EOF) {
-        putc(c, fptext);
-    }
-
-    fseek(fptext, (long) StartNewText, 0);
-
-    /* eliminate dupl. words by hashing into a h.table */
-    /* also, randomizes them somehow */
-    rewind(fpinp);
-    inithash(); /* initialize the hash table */
-    while (getword(fpinp, word) != EOF) {
-        if (!iscommon(word)) {
-            strtolow(word); /* turn to lower case only */
-            inhash(word);
-        }
-    }
-#ifdef DEBUG
-    hprint(); /* just for testing */
-#endif
+    /* Concatenate the new text file to the file "TEXTFILE",
+       before its words are turned to lower case in memory */
+    TokOpen(&tok, fpinp);
+    StartNewText = TextAppend(tok.Buf, tok.Len);
 
-    while (hgetnext(word) != EOH)
-        InsertTree(word, StartNewText);
+    /* eliminate dupl. words by hashing into a h.table, which counts
+       them, and notes their positions */
+    /* and gives them back in alphabetical order */
+    if (tab.Slots == NULL)
+        inithash(&tab); /* initialize the hash table */
+    TextWords(&tok, &tab);
+    TextIndex(StartNewText, tok.Len, fname, &tab);
 
-    hfree(); /* empties the hash table */
+    hfree(&tab); /* empties the hash table */
+    TokClose(&tok);
 
     fclose(fpinp);
 }
@@ -1,17 +1,20 @@
 #include "defn.g"
-#include "comwords.h"
+#include <string.h>
+#include "stophash.h"
 
 /* returns TRUE (=1) if 'word' is in the list
-   of common words
+   of common words.
+   The list is a perfect hash table, made from comwords.h (or the
+   STOPLIST of the makefile) by mkstophash.c: 'word' can only be the
+   common word in its slot.
  */
 
-extern int binsearch(char *word, char **array, int n);
-
 int iscommon(char *word) {
-    int pos;
+    unsigned int len = strlen(word);
+    unsigned int h;
 
-    if ((pos = binsearch(word, comwords, NO_COMMON_WORDS)) == ERROR)
+    if ((len == 0) || (len > STOPMAXLEN))
         return (FALSE);
-    else
-        return (TRUE);
+    h = STOPHASH(word, len);
+    return ((StopLens[h] == len) && (memcmp(word, StopWords[h], len) == 0));
 }
@@ -2,14 +2,12 @@
 
 #include "def.h"
 
-extern long LISTSIZE[100];
-
-int isfull(int count) {
-    int i = 0;
-    while (count >= LISTSIZE[i]) {
-        if (LISTSIZE[i] == count)
-            return (TRUE);
-        i++;
-    }
-    return (FALSE);
+extern long LISTSIZE[NUMLISTS];
+
+extern int SizeClass(long size);
+
+/* TRUE if a postings record with 'Used' bytes of postings has
+   no room for 'Extra' more bytes (see postrec.c) */
+int isfull(long Used, int Extra) {
+    return (Used + Extra > LISTSIZE[SizeClass(Used)]);
 }
@@ -0,0 +1,59 @@
+/* keycmp.c */
+
+/*  Operations on keys of known length (the length is stored with each
+    key, see slotpage.c), which need no terminating EOS: the prefix two
+    keys share, for the front coding of the leaves, and the separator
+    of two keys, for the nonleaf pages.
+
+    The keys themselves are compared by SlotCompare() (slotpage.c),
+    with memcmp() over the shorter length.  Reducing each key to an
+    8-byte "normalized prefix" first turned out slower ("make cmpbench"):
+    the prefix of a stored key has to be assembled byte by byte at every
+    comparison, which costs more than the memcmp() it avoids.
+*/
+
+#include "def.h"
+
+/* the number of leading bytes the keys (Key, KeyLen) and (Word, WordLen)
+   have in common */
+int KeyShared(char *Key, int KeyLen, char *Word, int WordLen) {
+    int i, n = min(KeyLen, WordLen);
+
+    for (i = 0; (i < n) && (Key[i] == Word[i]); i++)
+        ;
+    return (i);
+}
+
+/* the shortest key Sep with Left <= Sep < Right, to separate the keys
+   (Left, LeftLen) < (Right, RightLen) in the parent of their pages,
+   so that the nonleaf pages hold short keys ("suffix truncation").
+   Sep gets MAXWORDSIZE + 1 bytes at most, terminated; returns its
+   length. */
+int KeySeparator(char *Left, int LeftLen, char *Right, int RightLen,
+                 char *Sep) {
+    int n = KeyShared(Left, LeftLen, Right, RightLen), j;
+    unsigned char c;
+
+    if (LeftLen > n + 1) {
+        /* the first byte where they differ is enough ... */
+        if (RightLen > n + 1) {
+            memcpy(Sep, Right, n + 1);
+            Sep[n + 1] = EOS;
+            return (n + 1);
+        }
+        /* ... or else Left cut after its first byte that can be
+           incremented, and incremented */
+        for (j = n; j < LeftLen - 1; j++) {
+            c = (unsigned char) Left[j];
+            if ((j > n) ? (c < 0xff) : (c + 1 < (unsigned char) Right[n])) {
+                memcpy(Sep, Left, j);
+                Sep[j] = (char) (c + 1);
+                Sep[j + 1] = EOS;
+                return (j + 1);
+            }
+        }
+    }
+    memcpy(Sep, Left, LeftLen);
+    Sep[LeftLen] = EOS;
+    return (LeftLen);
+}
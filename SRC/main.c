@@ -19,8 +19,10 @@
 /* this array containts the (growing) sizes of the
  * postings records */
 
-long LISTSIZE[100];
+long LISTSIZE[NUMLISTS];
 extern int btReadCount;
+extern int bufHitCount, bufMissCount, bufEvictCount;
+extern int bufWriteCount, bufPagesWritten;
 
 extern FILE *fpbtree, *fppost, *fptext;
 extern void print_and_reset_stats();
@@ -28,10 +30,20 @@ extern int setparms(void);
 extern int dbopen(void);
 extern void scanTree(void (*f)(struct KeyRecord *));
 extern int insert(char *fname);
+extern void ingest(char *Path);
+extern void bulkload(char *listname, int fill);
+extern void buildIndex(int fill);
 extern int search(char *key, int flag);
-extern int printPage(PAGENO i, FILE *fpb);
+extern int readquery(char *Line);
+extern void query(char *Line);
+extern void rank(char *Line, int k);
+extern void phrase(char *Line, int Dist);
+extern void PostCompact(void);
+extern int printPage(PAGENO i);
 extern void PrintTreeInOrder(PAGENO pgNum, int level);
 extern int dbclose(void);
+extern void dbsync(void);
+extern void AccFlush(void);
 extern void printKey(struct KeyRecord *p);
 extern void printOcc(struct KeyRecord *p);
 extern int get_predecessors(char *key, int k);
@@ -44,6 +56,7 @@ int main(int argc, char **argv) {
     char word[MAXWORDSIZE];
     char cmd[MAXWORDSIZE];   /* string to hold a command */
     char fname[MAXWORDSIZE]; /* name of input file */
+    char line[MAXQUERYSIZE]; /* a boolean query */
     PAGENO i;
     int goOn;
     int  k;
@@ -56,17 +69,27 @@ int main(int argc, char **argv) {
         printf("\n\t*** These are your commands .........\n");
         printf("\t\"C\" to scan the tree\n");
         printf("\t\"i\" to insert\n");
+        printf("\t\"I\" to insert a list of files, or a directory\n");
+        printf("\t\"B\" to bulk load a list of files into an empty index\n");
         printf("\t\"p\" to print a btree page\n");
         printf("\t\"s\" to search, and print the key\n");
         printf("\t\"S\" to search, and print the key, posting list pairs\n");
+        printf("\t\"Q\" to search for an AND/OR/NOT query of words\n");
+        printf("\t\"R\" to print the k documents that rank best for words\n");
+        printf("\t\"P\" to search for a phrase, or for words near each "
+               "other\n");
         printf("\t\">\" to print k successors\n");
         printf("\t\"<\" to print k predecessors\n");
         printf("\t\"T\" to print the btree in inorder format\n");
+        printf("\t\"K\" to compact the postings file\n");
+        printf("\t\"r\" to rebuild the index from the text file\n");
         printf("\t\"#\" to reset and print stats\n");
         printf("\t\"x\" to exit\n");
         /* printf("\"d\" to display statistics, \"c\" to clear them,\n"); */
         scanf("%s", cmd);
         assert(strlen(cmd) < MAXWORDSIZE);
+        if (cmd[0] != 'i')
+            AccFlush(); /* the insertions before it reach the index */
         switch (cmd[0]) {
         case 'C':
             printf("\n*** Scanning... \n");
@@ -79,6 +102,22 @@ int main(int argc, char **argv) {
             printf("\n*** Inserting %s\n", fname);
             insert(fname);
             break;
+        case 'I':
+            printf("\tgive list file or directory name: ");
+            scanf("%s", fname);
+            assert(strlen(fname) < MAXWORDSIZE);
+            printf("\n*** Inserting the files of %s\n", fname);
+            ingest(fname);
+            break;
+        case 'B':
+            printf("\tgive list file name: ");
+            scanf("%s", fname);
+            assert(strlen(fname) < MAXWORDSIZE);
+            printf("\tfill factor (%%)=? ");
+            scanf("%d", &k);
+            printf("\n*** Bulk loading %s\n", fname);
+            bulkload(fname, k);
+            break;
         case 's':
             printf("enter search-word: ");
             scanf("%s", word);
@@ -93,12 +132,37 @@ int main(int argc, char **argv) {
             printf("\n*** Searching for word %s \n", word);
             search(word, TRUE);
             break;
+        case 'Q':
+            printf("enter query: ");
+            if (readquery(line)) {
+                printf("\n*** Querying %s \n", line);
+                query(line);
+            }
+            break;
+        case 'R':
+            printf("enter search-words: ");
+            if (readquery(line)) {
+                printf("k=?\n");
+                scanf("%d", &k);
+                printf("\n*** Ranking for %s \n", line);
+                rank(line, k);
+            }
+            break;
+        case 'P':
+            printf("enter phrase: ");
+            if (readquery(line)) {
+                printf("distance=?\n");
+                scanf("%d", &k);
+                printf("\n*** Phrase %s, distance %d \n", line, k);
+                phrase(line, k);
+            }
+            break;
         case 'p':
             printf("pagenumber=?\n");
             scanf("%s", cmd);
             assert(strlen(cmd) < MAXWORDSIZE);
             i = (PAGENO) atoi(cmd);
-            printPage(i, fpbtree);
+            printPage(i);
             break;
         case '>':
             printf("word=?\n");
@@ -118,9 +182,25 @@ int main(int argc, char **argv) {
             printf("\n*** Printing tree in order .........\n");
             PrintTreeInOrder(ROOT, 0);
             break;
+        case 'K':
+            printf("\n*** Compacting the postings file .........\n");
+            PostCompact();
+            break;
+        case 'r':
+            printf("\tfill factor (%%)=? ");
+            scanf("%d", &k);
+            printf("\n*** Rebuilding the index from TEXTFILE\n");
+            buildIndex(k);
+            break;
         case '#':
             printf("# of reads on B-tree: %d\n", btReadCount);
+            printf("# of buffer pool hits: %d, misses: %d, evictions: %d\n",
+                   bufHitCount, bufMissCount, bufEvictCount);
+            printf("# of pages written back: %d, in %d writes\n",
+                   bufPagesWritten, bufWriteCount);
             btReadCount = 0;
+            bufHitCount = bufMissCount = bufEvictCount = 0;
+            bufPagesWritten = bufWriteCount = 0;
             break;
         case 'x':
             printf("\n*** Exiting .........\n");
@@ -130,6 +210,7 @@ int main(int argc, char **argv) {
             printf("\n*** Illegal command \"%s\"\n", cmd);
             break;
         }
+        dbsync(); /* the changes made by the command reach the files */
     }
 
     dbclose();
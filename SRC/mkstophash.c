@@ -0,0 +1,140 @@
+/* mkstophash.c */
+
+/*  Generates stophash.h, the perfect hash table of the common words
+    for iscommon(), from the list of common words: STOPLIST, a header
+    in the form of comwords.h (see the makefile).
+
+    A word hashes on its length and on five of its characters: the
+    first, the second, the last, and the one or two in the middle (the
+    same one if the length is even).  The second is the EOS of a word
+    of one letter.  In 32-bit arithmetic,
+
+        h = (Len * K[0] + w[0] * K[1] + w[1] * K[2] + w[Len / 2] * K[3]
+             + w[(Len + 1) / 2] * K[4] + w[Len - 1] * K[5])
+            >> (32 - STOPBITS)
+
+    The program tries random multipliers K, for tables of 2, 4, 8 ...
+    times as many slots as words, until no two common words share a
+    slot; it fails if two words have the same length and characters
+    there.  The table then holds each common word in its slot, with its
+    length, and iscommon() needs one memcmp() with the only word that
+    could match.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef STOPLIST
+#define STOPLIST "comwords.h"
+#endif
+#include STOPLIST
+
+#define MAXSTOPBITS (16) /* the largest table tried: 2^16 slots */
+#define TRIES (100000)   /* multipliers tried for each size */
+
+#define NUMK (6) /* multipliers */
+
+static unsigned int K[NUMK];
+static int Bits;
+
+static unsigned int Hash(char *w) {
+    unsigned int len = strlen(w);
+
+    return ((len * K[0] + (unsigned char) w[0] * K[1] +
+             (unsigned char) w[1] * K[2] + (unsigned char) w[len / 2] * K[3] +
+             (unsigned char) w[(len + 1) / 2] * K[4] +
+             (unsigned char) w[len - 1] * K[5]) >> (32 - Bits));
+}
+
+/* TRUE if the words 'a' and 'b' look the same to Hash() */
+static int SameKey(char *a, char *b) {
+    unsigned int len = strlen(a);
+
+    return ((strlen(b) == len) && (a[0] == b[0]) && (a[1] == b[1]) &&
+            (a[len / 2] == b[len / 2]) &&
+            (a[(len + 1) / 2] == b[(len + 1) / 2]) &&
+            (a[len - 1] == b[len - 1]));
+}
+
+static unsigned int Random(void) {
+    return (((unsigned int) rand() << 16) ^ (unsigned int) rand()) | 1;
+}
+
+/* TRUE if the multipliers K put the words in different slots of 'Slot' */
+static int Perfect(int *Slot) {
+    unsigned int i, h;
+
+    memset(Slot, -1, sizeof(int) << Bits);
+    for (i = 0; i < NO_COMMON_WORDS; i++) {
+        h = Hash(comwords[i]);
+        if (Slot[h] != -1)
+            return (0);
+        Slot[h] = i;
+    }
+    return (1);
+}
+
+int main(void) {
+    int *slot = (int *) malloc(sizeof(int) << MAXSTOPBITS);
+    unsigned int i, j, k, maxlen = 0;
+    int t;
+
+    for (i = 0; i < NO_COMMON_WORDS; i++) {
+        if (comwords[i][0] == '\0') {
+            fprintf(stderr, "mkstophash: empty word in %s\n", STOPLIST);
+            exit(-1);
+        }
+        if (strlen(comwords[i]) > maxlen)
+            maxlen = strlen(comwords[i]);
+        for (j = 0; j < i; j++)
+            if (SameKey(comwords[i], comwords[j])) {
+                fprintf(stderr, "mkstophash: \"%s\" and \"%s\" hash the"
+                        " same in %s\n", comwords[j], comwords[i], STOPLIST);
+                exit(-1);
+            }
+    }
+    srand(15615);
+    for (Bits = 1; (1U << Bits) < 2 * NO_COMMON_WORDS; Bits++)
+        ;
+    for (; Bits <= MAXSTOPBITS; Bits++)
+        for (t = 0; t < TRIES; t++) {
+            for (k = 0; k < NUMK; k++)
+                K[k] = Random();
+            if (Perfect(slot))
+                goto found;
+        }
+    fprintf(stderr, "mkstophash: no perfect hash for %s\n", STOPLIST);
+    exit(-1);
+
+found:
+    printf("/* stophash.h: generated by mkstophash from %s - do not edit */\n"
+           "\n",
+           STOPLIST);
+    printf("#define STOPBITS (%d)\n", Bits);
+    printf("#define STOPMAXLEN (%u)\n", maxlen);
+    printf("#define STOPHASH(w, len) \\\n"
+           "    (((unsigned int) (len) * %uU + \\\n"
+           "      (unsigned int) (unsigned char) (w)[0] * %uU + \\\n"
+           "      (unsigned int) (unsigned char) (w)[1] * %uU + \\\n"
+           "      (unsigned int) (unsigned char) (w)[(len) / 2] * %uU + \\\n"
+           "      (unsigned int) (unsigned char) (w)[((len) + 1) / 2]"
+           " * %uU + \\\n"
+           "      (unsigned int) (unsigned char) (w)[(len) - 1] * %uU) \\\n"
+           "     >> (32 - STOPBITS))\n"
+           "\n",
+           K[0], K[1], K[2], K[3], K[4], K[5]);
+    printf("static const char *const StopWords[1 << STOPBITS] = {\n");
+    for (i = 0; i < (1U << Bits); i++)
+        if (slot[i] != -1)
+            printf("    [%u] = \"%s\",\n", i, comwords[slot[i]]);
+    printf("};\n\n");
+    printf("static const unsigned char StopLens[1 << STOPBITS] = {\n");
+    for (i = 0; i < (1U << Bits); i++)
+        if (slot[i] != -1)
+            printf("    [%u] = %u,\n", i,
+                   (unsigned int) strlen(comwords[slot[i]]));
+    printf("};\n");
+    free(slot);
+    return (0);
+}
@@ -0,0 +1,223 @@
+/* phrase.c */
+
+/*  Phrase and proximity queries (command "P"), on an index that keeps
+    the positions of the words (POSITIONS, see postrec.c).
+
+    With distance 0, a document matches if it has the words of the
+    query one after the other, in that order: "new york city" matches
+    where "york" is at the position after "new", and "city" after that.
+    Common words are not indexed, but they keep their place: "bank of
+    england" matches "bank", any word, then "england".
+
+    With distance k > 0, a document matches if it has all the words, in
+    any order, within a stretch of k more words than the query has:
+    "apple pie" with distance 4 matches "pie made of apples and apple",
+    a stretch of 6 words from "pie" to "apple", at most 2 + 4.  Each
+    word counts once.
+
+    The documents with all the words are found as for an AND query
+    (query.c): the cursor of the rarest word proposes a document, and
+    the others confirm it or seek past it.  Only for those documents
+    are the positions of the words merged, in one pass over each list.
+*/
+
+#include "def.h"
+
+#define MAXPHRASEWORDS (64) /* words in a phrase, at most */
+
+struct PhraseWord {
+    char Word[MAXWORDSIZE];
+    struct PostCursor Cursor;
+    POSTCOUNT Off; /* its position in the phrase */
+};
+
+extern int sqCount, uqCount;
+
+extern int iscommon(char *word);
+extern int check_word(char *word);
+extern int strtolow(char *s);
+extern POSTINGSPTR treesearch(PAGENO PageNo, char *key);
+extern void DocPrint(DOCID Doc);
+extern void CursorOpen(struct PostCursor *C, POSTINGSPTR pptr, int Where);
+extern DOCID CursorDoc(struct PostCursor *C);
+extern DOCID CursorSeek(struct PostCursor *C, DOCID Target);
+extern POSTCOUNT CursorTf(struct PostCursor *C);
+extern POSTCOUNT *CursorWhere(struct PostCursor *C);
+extern void CursorClose(struct PostCursor *C);
+
+static struct PhraseWord Words[MAXPHRASEWORDS];
+static int NumWords;
+static POSTCOUNT Span; /* positions taken by the phrase */
+
+/* from the fewest documents up */
+static int WordOrder(const void *a, const void *b) {
+    struct PhraseWord *x = (struct PhraseWord *) a;
+    struct PhraseWord *y = (struct PhraseWord *) b;
+
+    return ((x->Cursor.Num > y->Cursor.Num) -
+            (x->Cursor.Num < y->Cursor.Num));
+}
+
+/* looks up the words of 'Line', each once unless 'Ordered'; FALSE if
+   some word has no documents, or is malformed */
+static int PhraseWords(char *Line, int Ordered) {
+    static char *blanks = " \t\r\n";
+    char *word;
+    int i, ok = TRUE;
+
+    NumWords = 0;
+    Span = 0;
+    for (word = strtok(Line, blanks); word != NULL;
+         word = strtok(NULL, blanks), Span++) {
+        if (strlen(word) >= MAXWORDSIZE) {
+            printf("phrase: word too long: %.20s...\n", word);
+            ok = FALSE;
+            continue;
+        }
+        if (iscommon(word)) {
+            printf("\"%s\" is a common word - any word matches it\n", word);
+            continue;
+        }
+        if (check_word(word) == FALSE) {
+            ok = FALSE;
+            continue;
+        }
+        strtolow(word);
+        for (i = 0; !Ordered && (i < NumWords); i++)
+            if (strcmp(Words[i].Word, word) == 0)
+                break;
+        if (!Ordered && (i < NumWords)) /* each word counts once */
+            continue;
+        if (NumWords == MAXPHRASEWORDS) {
+            printf("phrase: more than %d words\n", MAXPHRASEWORDS);
+            ok = FALSE;
+            break;
+        }
+
+        strcpy(Words[NumWords].Word, word);
+        Words[NumWords].Off = Span;
+        CursorOpen(&Words[NumWords].Cursor, treesearch(ROOT, word), TRUE);
+        if (Words[NumWords].Cursor.Num == 0) {
+            printf("key \"%s\": not found\n", word);
+            ok = FALSE;
+        }
+        NumWords++;
+    }
+    return (ok);
+}
+
+/* the next document >= 'Target' that has all the words, or ENDOFLIST */
+static DOCID AllWords(DOCID Target) {
+    DOCID d, e;
+    int i;
+
+    for (d = Target;;) {
+        d = CursorSeek(&Words[0].Cursor, d);
+        for (e = d, i = 1; (d != ENDOFLIST) && (i < NumWords); i++)
+            if ((e = CursorSeek(&Words[i].Cursor, d)) != d)
+                break;
+        if (e == d)
+            return (d);
+        d = e;
+    }
+}
+
+/* TRUE if the words, under their cursors, are in place for the phrase:
+   each word at its offset from the start of the phrase */
+static int InPlace(void) {
+    POSTCOUNT *where[MAXPHRASEWORDS], *end[MAXPHRASEWORDS], *p, *pend;
+    POSTCOUNT start;
+    int i;
+
+    for (i = 0; i < NumWords; i++) {
+        where[i] = CursorWhere(&Words[i].Cursor);
+        end[i] = where[i] + CursorTf(&Words[i].Cursor);
+    }
+    /* every place of the rarest word may start the phrase */
+    for (p = where[0], pend = end[0]; p < pend; p++) {
+        if (*p < Words[0].Off)
+            continue;
+        start = *p - Words[0].Off;
+        for (i = 1; i < NumWords; i++) {
+            while ((where[i] < end[i]) && (*where[i] < start + Words[i].Off))
+                where[i]++;
+            if (where[i] == end[i])
+                return (FALSE);
+            if (*where[i] != start + Words[i].Off)
+                break;
+        }
+        if (i == NumWords)
+            return (TRUE);
+    }
+    return (FALSE);
+}
+
+/* TRUE if the words, under their cursors, are all within a stretch of
+   Span + 'Dist' positions: the least position of each list is moved
+   forward until the stretch from the least to the largest is short
+   enough, or a list runs out */
+static int Near(int Dist) {
+    POSTCOUNT *where[MAXPHRASEWORDS], *end[MAXPHRASEWORDS], lo, hi;
+    int i, least;
+
+    for (i = 0; i < NumWords; i++) {
+        where[i] = CursorWhere(&Words[i].Cursor);
+        end[i] = where[i] + CursorTf(&Words[i].Cursor);
+    }
+    for (;;) {
+        for (least = 0, lo = hi = *where[0], i = 1; i < NumWords; i++) {
+            if (*where[i] < lo) {
+                lo = *where[i];
+                least = i;
+            }
+            hi = max(hi, *where[i]);
+        }
+        if (hi - lo < Span + Dist)
+            return (TRUE);
+        if (++where[least] == end[least])
+            return (FALSE);
+    }
+}
+
+/* prints the documents that have the words of 'Line' as a phrase, or,
+   if 'Dist' > 0, within 'Dist' more words than the phrase */
+void phrase(char *Line, int Dist) {
+    int docCount = 0, i, ok;
+    long candidates = 0;
+    DOCID d;
+
+    if (!POSITIONS) {
+        printf("phrase: the index keeps no word positions - ");
+        printf("build it with \"positions 1\" in parms\n");
+        return;
+    }
+    if (Dist < 0) {
+        printf("phrase: the distance must not be negative\n");
+        return;
+    }
+    ok = PhraseWords(Line, Dist == 0);
+    if (ok && (NumWords == 0)) {
+        printf("phrase: nothing to search for\n");
+        ok = FALSE;
+    }
+
+    if (ok) {
+        qsort(Words, NumWords, sizeof(struct PhraseWord), WordOrder);
+        for (d = AllWords(0); d != ENDOFLIST; d = AllWords(d + 1)) {
+            candidates++;
+            if (!((Dist == 0) ? InPlace() : Near(Dist)))
+                continue;
+            printf("-------document #%d-----\n", ++docCount);
+            DocPrint(d);
+        }
+    }
+    printf("\n%d document(s) match, of %ld with all the words\n", docCount,
+           candidates);
+    if (docCount > 0)
+        sqCount++;
+    else
+        uqCount++;
+
+    for (i = 0; i < NumWords; i++)
+        CursorClose(&Words[i].Cursor);
+}
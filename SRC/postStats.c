@@ -1,11 +1,13 @@
 #include "def.h"
 
 extern FILE *fppost;
-extern long LISTSIZE[100];
+extern long LISTSIZE[NUMLISTS];
+extern POSTINGSPTR FreeHead[NUMLISTS];
 extern double GF;
 
 /* this function scans the free lists and prints
-   the number of free records for each  record-size.
+   the number of free records for each  record-size
+   (in bytes of encoded postings, see postrec.c).
  */
 
 int getcount(int i);
@@ -14,7 +16,6 @@ void postStats(void) {
     int i = 0, n = 0;
     int totempty;
 
-    rewind(fppost);
     totempty = 0;
     for (i = 0; i < 20; i++) {
         printf("size:%ld ", LISTSIZE[i]);
@@ -22,7 +23,7 @@ void postStats(void) {
         printf(" count:%d\n", n);
         totempty += LISTSIZE[i] * n;
     }
-    printf("ExtFragm: %d empty slots, 4(?) bytes each\n", totempty);
+    printf("ExtFragm: %d empty bytes\n", totempty);
     printf("growth factor:%g\n", GF);
 }
 
@@ -30,8 +31,7 @@ int getcount(int i) {
     int n = 0;
     POSTINGSPTR nextptr;
 
-    fseek(fppost, (long) i * sizeof(POSTINGSPTR), 0);
-    fread(&nextptr, sizeof(nextptr), 1, fppost);
+    nextptr = FreeHead[i];
     while (nextptr != (-1)) {
         n++;
         fseek(fppost, (long) nextptr, 0);
@@ -0,0 +1,143 @@
+/* postbench.c */
+
+/*  Benchmark of the postings formats ("make postbench").
+
+    Reads the names of the Datafiles on the standard input, and numbers
+    the documents as loading them would (see doctable.c).  It then
+    builds the postings lists of terms that occur in every
+    document, every 4th, every 16th, and in a random tenth of them, and
+    times decoding them
+        - "varint": every delta in a varint, as before the blocks,
+        - "blocks": the format of postrec.c, once with each decoder of
+          bitpack.c that this CPU can run,
+    reporting bytes and nanoseconds per document.  Every term frequency
+    is 1, which the blocks store in no bits at all, and only the
+    documents are decoded.  Every decoding is checked against
+    the list.
+*/
+
+#include "def.h"
+#include <time.h>
+
+#define MINDECODED (20000000L) /* documents decoded per timing */
+
+extern int VarintPut(unsigned char *Buf, unsigned long V);
+extern int VarintGet(unsigned char *Buf, unsigned long *V);
+extern long PostEncode(DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where,
+                       NUMPTRS Num, unsigned char *Buf);
+extern DOCID PostDecode(unsigned char *Buf, NUMPTRS Num, DOCID *Docs,
+                        POSTCOUNT *Tfs, POSTCOUNT *Where);
+extern int BitUnpackUse(char *Name);
+extern char *BitUnpackName;
+
+FILE *fppost; /* for postrec.c, which is linked in */
+int pReadCount, pWriteCount;
+int POSITIONS = FALSE;
+
+static POSTCOUNT *Ones; /* term frequencies */
+static long NumDocs;
+
+/* reads the file names: the documents */
+static void ReadDocs(void) {
+    char name[1024];
+
+    while (scanf("%1023s", name) == 1)
+        NumDocs++;
+}
+
+/* the varint format: the deltas only */
+static long VarintEncode(DOCID *Docs, long Num, unsigned char *Buf) {
+    DOCID prev = 0;
+    long i, n = 0;
+
+    for (i = 0; i < Num; i++) {
+        n += VarintPut(Buf + n, (unsigned long) (Docs[i] - prev));
+        prev = Docs[i];
+    }
+    return (n);
+}
+
+static void VarintDecode(unsigned char *Buf, long Num, DOCID *Docs) {
+    DOCID doc = 0;
+    unsigned long delta;
+    long i;
+
+    for (i = 0; i < Num; i++) {
+        Buf += VarintGet(Buf, &delta);
+        Docs[i] = doc += (DOCID) delta;
+    }
+}
+
+/* times decoding the list 'Docs' in the format 'Blocks' (or varint) */
+static void Time(char *Name, int Blocks, DOCID *Docs, long Num,
+                 unsigned char *Buf, DOCID *Out) {
+    long bytes, reps, r;
+    clock_t start;
+    double t;
+
+    bytes = Blocks ? PostEncode(Docs, Ones, NULL, Num, Buf)
+                   : VarintEncode(Docs, Num, Buf);
+    reps = MINDECODED / Num + 1;
+    start = clock();
+    for (r = 0; r < reps; r++)
+        if (Blocks)
+            PostDecode(Buf, Num, Out, NULL, NULL);
+        else
+            VarintDecode(Buf, Num, Out);
+    t = (double) (clock() - start) / CLOCKS_PER_SEC;
+    if (memcmp(Docs, Out, sizeof(DOCID) * Num) != 0) {
+        printf("postbench: %s decoded the list wrong\n", Name);
+        exit(-1);
+    }
+    printf("    %-14s %5.2f bytes, %5.2f ns per document\n", Name,
+           (double) bytes / Num, 1e9 * t / (reps * Num));
+}
+
+int main(void) {
+    static char *decoders[] = {"scalar", "sse2", "avx2"};
+    static int steps[] = {1, 4, 16, 0}; /* 0: a random tenth */
+    DOCID *docs, *out;
+    unsigned char *buf;
+    char name[100];
+    long num, i;
+    int s, d;
+
+    ReadDocs();
+    if (NumDocs < BLOCKSIZE) {
+        printf("postbench: give the names of the Datafiles on the standard");
+        printf(" input\n");
+        exit(-1);
+    }
+    printf("%ld documents\n", NumDocs);
+
+    docs = (DOCID *) malloc(sizeof(DOCID) * NumDocs);
+    out = (DOCID *) malloc(sizeof(DOCID) * NumDocs);
+    buf = (unsigned char *) malloc(2 * MAXVARINT * NumDocs + POSTSLACK);
+    Ones = (POSTCOUNT *) malloc(sizeof(POSTCOUNT) * NumDocs);
+    ck_malloc(docs, "docs");
+    ck_malloc(out, "out");
+    ck_malloc(buf, "buf");
+    ck_malloc(Ones, "Ones");
+    for (i = 0; i < NumDocs; i++)
+        Ones[i] = 1;
+    srand(1);
+    for (s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        for (num = 0, i = 0; i < NumDocs; i++)
+            if ((steps[s] > 0) ? (i % steps[s] == 0) : (rand() % 10 == 0))
+                docs[num++] = (DOCID) i;
+        if (steps[s] > 0)
+            printf("term in every %d document(s): %ld documents\n",
+                   steps[s], num);
+        else
+            printf("term in a random tenth of the documents: %ld"
+                   " documents\n", num);
+
+        Time("varint", FALSE, docs, num, buf, out);
+        for (d = 0; d < sizeof(decoders) / sizeof(decoders[0]); d++)
+            if (BitUnpackUse(decoders[d])) {
+                sprintf(name, "blocks/%s", BitUnpackName);
+                Time(name, TRUE, docs, num, buf, out);
+            }
+    }
+    return (0);
+}
@@ -0,0 +1,183 @@
+/* postcursor.c */
+
+/*  Cursors over postings lists, for the queries that walk several
+    lists together, one document at a time (see query.c).
+
+    A cursor holds the encoded postings record of one term, and a
+    position in it.  It decodes one block of BLOCKSIZE postings at a
+    time (or the tail of the record), when it gets there: the headers
+    of the blocks serve as skip entries (PostSkips(), see postrec.c),
+    so the blocks that a seek jumps over are never decoded.
+
+    CursorSeek() moves the cursor forward to the first document >= a
+    target by galloping, first over the last documents of the
+    blocks, to find the block that holds the target, and then within
+    that block: it probes 1, 2, 4, ... entries ahead until it passes
+    the target, and then binary-searches the last step.  A seek thus
+    costs the log of the distance it skips, plus the decoding of one
+    block, so intersecting a short list with a long one costs about the
+    short list times the log of the long one, not the sum of the two.
+
+    With POSITIONS, a cursor opened for them also holds the positions
+    of its term in each document of the block, for phrase queries
+    (phrase.c).
+*/
+
+#include "def.h"
+
+extern DOCID PostDecodeAt(unsigned char *Buf, NUMPTRS Num, DOCID Base,
+                          DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where);
+extern NUMPTRS PostSkips(unsigned char *Buf, NUMPTRS Num, DOCID *Max,
+                         long *Off);
+extern unsigned char *PostRead(POSTINGSPTR pptr, struct PostHdr *Hdr);
+
+/* opens the cursor 'C' on the postings record at 'pptr' (an empty list
+   if NONEXISTENT), before its first document; it reads the positions
+   too if 'Where' is TRUE, which needs POSITIONS */
+void CursorOpen(struct PostCursor *C, POSTINGSPTR pptr, int Where) {
+    struct PostHdr hdr;
+    NUMPTRS nskips;
+
+    assert(!Where || POSITIONS);
+    C->Buf = NULL;
+    C->Bytes = 0;
+    C->SkipMax = NULL;
+    C->SkipOff = NULL;
+    C->NumBlocks = 0;
+    C->Block = -1;
+    C->Docs = NULL;
+    C->Tfs = NULL;
+    C->Where = NULL;
+    C->WhereAt = NULL;
+    C->WantWhere = Where;
+    C->MaxTf = 0;
+    C->Num = 0;
+    C->Pos = 0;
+    if (pptr == NONEXISTENT)
+        return;
+    C->Buf = PostRead(pptr, &hdr);
+    C->Bytes = hdr.NumBytes;
+    C->Num = hdr.NumPtrs;
+    C->MaxTf = hdr.MaxTf;
+    nskips = C->Num / BLOCKSIZE + 1;
+    C->SkipMax = (DOCID *) malloc(sizeof(DOCID) * nskips);
+    C->SkipOff = (long *) malloc(sizeof(long) * nskips);
+    C->Docs = (DOCID *) malloc(sizeof(DOCID) * BLOCKSIZE);
+    C->Tfs = (POSTCOUNT *) malloc(sizeof(POSTCOUNT) * BLOCKSIZE);
+    ck_malloc(C->SkipMax, "C->SkipMax");
+    ck_malloc(C->SkipOff, "C->SkipOff");
+    ck_malloc(C->Docs, "C->Docs");
+    ck_malloc(C->Tfs, "C->Tfs");
+    if (Where) {
+        C->WhereAt = (NUMPTRS *) malloc(sizeof(NUMPTRS) * (BLOCKSIZE + 1));
+        ck_malloc(C->WhereAt, "C->WhereAt");
+    }
+    C->NumBlocks = PostSkips(C->Buf, C->Num, C->SkipMax, C->SkipOff);
+}
+
+/* decodes the block 'b' (NumBlocks for the tail), unless it is the one
+   decoded already */
+static void CursorLoad(struct PostCursor *C, NUMPTRS b) {
+    NUMPTRS n, i;
+    long bytes;
+
+    if (C->Block == b)
+        return;
+    if (b < C->NumBlocks) {
+        n = BLOCKSIZE;
+        bytes = C->SkipOff[b + 1] - C->SkipOff[b];
+    } else {
+        n = C->Num - b * BLOCKSIZE;
+        bytes = C->Bytes - C->SkipOff[b];
+    }
+    if (C->WantWhere) { /* at most one position per byte */
+        free(C->Where);
+        C->Where = (POSTCOUNT *) malloc(sizeof(POSTCOUNT) * (bytes + 1));
+        ck_malloc(C->Where, "C->Where");
+    }
+    PostDecodeAt(C->Buf + C->SkipOff[b], n, (b > 0) ? C->SkipMax[b - 1] : 0,
+                 C->Docs, C->Tfs, C->Where);
+    if (C->WantWhere)
+        for (C->WhereAt[0] = 0, i = 0; i < n; i++)
+            C->WhereAt[i + 1] = C->WhereAt[i] + C->Tfs[i];
+    C->Block = b;
+}
+
+/* the document under the cursor, or ENDOFLIST past the end */
+DOCID CursorDoc(struct PostCursor *C) {
+    if (C->Pos >= C->Num)
+        return (ENDOFLIST);
+    CursorLoad(C, C->Pos / BLOCKSIZE);
+    return (C->Docs[C->Pos % BLOCKSIZE]);
+}
+
+/* the first of A[low .. n - 1] >= 'Target', or n, galloping from A[low] */
+static NUMPTRS Gallop(DOCID *A, NUMPTRS low, NUMPTRS n, DOCID Target) {
+    NUMPTRS high, step = 1, mid;
+
+    if ((low >= n) || (A[low] >= Target))
+        return (low);
+    /* A[low] < Target: gallop until A[high] >= Target */
+    for (high = low + 1; (high < n) && (A[high] < Target);
+         high = low + step) {
+        low = high;
+        step *= 2;
+    }
+    high = min(high, n);
+    /* the first of A[low + 1 .. high - 1] >= Target, or high */
+    for (low++; low < high;) {
+        mid = (low + high) / 2;
+        if (A[mid] < Target)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return (low);
+}
+
+/* moves the cursor forward (never back) to the first document
+   >= 'Target', and returns it, or ENDOFLIST */
+DOCID CursorSeek(struct PostCursor *C, DOCID Target) {
+    NUMPTRS b, first;
+
+    if (CursorDoc(C) >= Target)
+        return (CursorDoc(C));
+    /* the block that holds Target: the first one whose last document
+       is >= Target, or else the tail */
+    b = C->Pos / BLOCKSIZE;
+    if ((b < C->NumBlocks) && (C->SkipMax[b] < Target)) {
+        b = Gallop(C->SkipMax, b, C->NumBlocks, Target);
+        C->Pos = b * BLOCKSIZE;
+        if (C->Pos >= C->Num)
+            return (ENDOFLIST);
+    }
+    CursorLoad(C, b);
+    first = b * BLOCKSIZE;
+    C->Pos = first + Gallop(C->Docs, C->Pos - first,
+                            min(C->Num - first, BLOCKSIZE), Target);
+    return (CursorDoc(C));
+}
+
+/* the term frequency under the cursor, which must not be past the end */
+POSTCOUNT CursorTf(struct PostCursor *C) {
+    CursorLoad(C, C->Pos / BLOCKSIZE);
+    return (C->Tfs[C->Pos % BLOCKSIZE]);
+}
+
+/* the positions of the term in the document under the cursor, which
+   must not be past the end, in increasing order; CursorTf() of them */
+POSTCOUNT *CursorWhere(struct PostCursor *C) {
+    CursorLoad(C, C->Pos / BLOCKSIZE);
+    return (C->Where + C->WhereAt[C->Pos % BLOCKSIZE]);
+}
+
+void CursorClose(struct PostCursor *C) {
+    free(C->Buf);
+    free(C->SkipMax);
+    free(C->SkipOff);
+    free(C->Docs);
+    free(C->Tfs);
+    free(C->Where);
+    free(C->WhereAt);
+    CursorOpen(C, NONEXISTENT, FALSE);
+}
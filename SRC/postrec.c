@@ -0,0 +1,407 @@
+/* postrec.c */
+
+/*  The format of a postings record in POSTINGSFILE.
+
+    A record starts with a header, written field by field:
+        NumPtrs     number of documents in the record
+        NumBytes    bytes taken by the encoded postings
+        MaxTf       the largest term frequency in the record
+    followed by room for LISTSIZE[c] bytes of encoded postings, for the
+    size class c of the record: c is SizeClass(NumBytes) (see
+    freelist.c), since a record that fills up moves to the smallest
+    class with room for its bytes, and NumBytes never goes down.
+    Packing the tail into a block (below) can make the postings
+    shorter; the bytes they no longer take are left at the end of the
+    record, counted in NumBytes and never decoded, so that isfull() and
+    freerec() still find the class of the room the record has.
+
+    The documents are given by their numbers (DOCID), not by their
+    offsets in TEXTFILE: DOCTABLE maps one to the other (doctable.c).
+    Each document comes with its term frequency (tf): the number of
+    times the word occurs in the document, for ranking (rank.c).
+
+    The documents are numbered as they are added, so they are in
+    increasing order, and each is stored as its difference with the
+    one before (the first one as itself); with dense numbers, the
+    differences of a frequent word are small.  The first NumPtrs /
+    BLOCKSIZE groups of BLOCKSIZE postings are packed in blocks, each
+    made of
+        Max         its last (largest) document, a DOCID
+        Bits        one byte: the bits of its largest delta
+        TfBits      one byte: the bits of its largest tf - 1
+        the deltas  bit-packed, BLOCKSIZE / 8 * Bits bytes (bitpack.c)
+        the tfs     each less 1, bit-packed, BLOCKSIZE / 8 * TfBits
+                    bytes - none at all if every tf is 1
+    so a block takes BlockBytes(Bits, TfBits) bytes, which is where the
+    next one starts, and Max is the base of the deltas of the next
+    block.
+
+    The remaining postings, fewer than BLOCKSIZE, form the tail of the
+    record: for each, its delta and its tf, in varints (7 bits per byte,
+    least significant first, the high bit set on every byte but the
+    last).  Appending a posting adds to the tail; the tail is packed
+    into a block when it reaches BLOCKSIZE postings.  Short lists are
+    thus all varints, and long ones are mostly blocks, decoded
+    BLOCKSIZE postings at a time.
+
+    With POSITIONS (see setparms.c), each posting also keeps the
+    positions of the word in its document: the numbers of the
+    occurrences among all the words of the document, common words
+    included, counting from 0, so that the words of a phrase are at
+    consecutive positions (see phrase.c).  There are tf of them,
+    increasing, each a varint of its difference with the one before
+    (the first one as itself).  A posting of the tail is followed by
+    its positions; a block ends with
+        PosBytes    a POSTCOUNT: the bytes of the positions that follow
+        the positions of its BLOCKSIZE postings, in order
+    so the documents alone are still decoded without reading them.
+
+    The headers of the blocks double as skip entries, one every
+    BLOCKSIZE postings: the Max of a block, and its length, known from
+    Bits, TfBits and PosBytes, lead from block to block without
+    decoding any (PostSkips()), so a reader looking for a document
+    decodes only the block that holds it (see postcursor.c).
+
+    The header is at least as large as a POSTINGSPTR, so that a free
+    record has room for the link of its free list.
+*/
+
+#include "def.h"
+
+extern FILE *fppost;
+extern int pReadCount, pWriteCount;
+
+extern int BitWidth(unsigned int *In);
+extern void BitPack(unsigned int *In, int Bits, unsigned char *Out);
+extern void (*BitUnpack)(unsigned char *In, int Bits, unsigned int *Out);
+
+/* writes 'V' as a varint in 'Buf'; returns its length */
+int VarintPut(unsigned char *Buf, unsigned long V) {
+    int n = 0;
+
+    while (V >= 0x80) {
+        Buf[n++] = (unsigned char) (V | 0x80);
+        V >>= 7;
+    }
+    Buf[n++] = (unsigned char) V;
+    return (n);
+}
+
+/* reads a varint from 'Buf' into *V; returns its length */
+int VarintGet(unsigned char *Buf, unsigned long *V) {
+    unsigned long v = 0;
+    int n = 0, shift = 0;
+
+    do {
+        v |= (unsigned long) (Buf[n] & 0x7f) << shift;
+        shift += 7;
+    } while (Buf[n++] & 0x80);
+    *V = v;
+    return (n);
+}
+
+/* the length of the block at 'Buf' */
+static long BlockLen(unsigned char *Buf) {
+    long n = BlockBytes(Buf[sizeof(DOCID)], Buf[sizeof(DOCID) + 1]);
+    POSTCOUNT posbytes;
+
+    if (POSITIONS) {
+        memcpy(&posbytes, Buf + n, sizeof(posbytes));
+        n += sizeof(posbytes) + posbytes;
+    }
+    return (n);
+}
+
+/* writes the 'Tf' positions of 'Where' in 'Buf'; returns their length */
+static long WhereEncode(POSTCOUNT *Where, POSTCOUNT Tf, unsigned char *Buf) {
+    POSTCOUNT prev = 0, j;
+    long n = 0;
+
+    for (j = 0; j < Tf; j++) {
+        assert((j == 0) || (Where[j] > prev));
+        n += VarintPut(Buf + n, (unsigned long) (Where[j] - prev));
+        prev = Where[j];
+    }
+    return (n);
+}
+
+/* reads 'Tf' positions from 'Buf' into 'Where', or skips them if it
+   is NULL; returns their length */
+static long WhereDecode(unsigned char *Buf, POSTCOUNT Tf, POSTCOUNT *Where) {
+    POSTCOUNT pos = 0, j;
+    unsigned long gap;
+    long n = 0;
+
+    if (Where == NULL) {
+        for (j = 0; j < Tf; n++)
+            if (!(Buf[n] & 0x80))
+                j++;
+        return (n);
+    }
+    for (j = 0; j < Tf; j++) {
+        n += VarintGet(Buf + n, &gap);
+        Where[j] = pos += (POSTCOUNT) gap;
+    }
+    return (n);
+}
+
+/* packs the BLOCKSIZE postings of 'Docs' and 'Tfs', whose documents
+   follow the document 'Base', in a block at 'Buf', with their
+   positions from 'Where' if POSITIONS; returns its length */
+static long BlockEncode(DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where,
+                        DOCID Base, unsigned char *Buf) {
+    unsigned int delta[BLOCKSIZE], tf[BLOCKSIZE];
+    unsigned char *p = Buf + BLOCKHDRSIZE;
+    DOCID prev = Base;
+    POSTCOUNT posbytes;
+    long len;
+    int i, bits, tfbits;
+
+    for (i = 0; i < BLOCKSIZE; i++) {
+        assert((Docs[i] >= prev) && (Tfs[i] >= 1));
+        delta[i] = (unsigned int) (Docs[i] - prev);
+        tf[i] = Tfs[i] - 1;
+        prev = Docs[i];
+    }
+    bits = BitWidth(delta);
+    BitPack(delta, bits, p);
+    tfbits = BitWidth(tf);
+    BitPack(tf, tfbits, p + BLOCKSIZE / 8 * bits);
+    memcpy(Buf, &Docs[BLOCKSIZE - 1], sizeof(DOCID));
+    Buf[sizeof(DOCID)] = (unsigned char) bits;
+    Buf[sizeof(DOCID) + 1] = (unsigned char) tfbits;
+    len = BlockBytes(bits, tfbits);
+
+    if (POSITIONS) {
+        p = Buf + len + sizeof(posbytes);
+        for (posbytes = 0, i = 0; i < BLOCKSIZE; Where += Tfs[i++])
+            posbytes += WhereEncode(Where, Tfs[i], p + posbytes);
+        memcpy(Buf + len, &posbytes, sizeof(posbytes));
+        len += sizeof(posbytes) + posbytes;
+    }
+    return (len);
+}
+
+/* unpacks the block at 'Buf', whose documents follow the document
+   'Base', into 'Docs', and its tfs into 'Tfs' (unless NULL).  If
+   'Where' is not NULL, the positions go to *Where, which is moved past
+   them; they need the tfs.  Returns the length of the block. */
+static long BlockDecode(unsigned char *Buf, DOCID Base, DOCID *Docs,
+                        POSTCOUNT *Tfs, POSTCOUNT **Where) {
+    unsigned int delta[BLOCKSIZE];
+    unsigned char *p = Buf + BLOCKHDRSIZE;
+    int i, bits = Buf[sizeof(DOCID)], tfbits = Buf[sizeof(DOCID) + 1];
+
+    BitUnpack(p, bits, delta);
+    for (i = 0; i < BLOCKSIZE; i++)
+        Docs[i] = Base += delta[i];
+    if (Tfs != NULL) {
+        BitUnpack(p + BLOCKSIZE / 8 * bits, tfbits, Tfs);
+        for (i = 0; i < BLOCKSIZE; i++)
+            Tfs[i]++;
+    }
+    if (Where != NULL) {
+        assert(POSITIONS && (Tfs != NULL));
+        p = Buf + BlockBytes(bits, tfbits) + sizeof(POSTCOUNT);
+        for (i = 0; i < BLOCKSIZE; *Where += Tfs[i++])
+            p += WhereDecode(p, Tfs[i], *Where);
+    }
+    return (BlockLen(Buf));
+}
+
+/* finds the tail of a record with 'Num' postings encoded in 'Buf':
+   returns its offset, and sets *Base to the document before it */
+static long TailOffset(unsigned char *Buf, NUMPTRS Num, DOCID *Base) {
+    long off = 0, last = 0;
+    NUMPTRS b;
+
+    *Base = 0;
+    for (b = 0; b < Num / BLOCKSIZE; b++) {
+        last = off;
+        off += BlockLen(Buf + off);
+    }
+    if (off > 0)
+        memcpy(Base, Buf + last, sizeof(DOCID)); /* Max of the last block */
+    return (off);
+}
+
+/* encodes the 'Num' postings of 'Docs' and 'Tfs' in 'Buf', with their
+   positions from 'Where' if POSITIONS ('Where' holds Tfs[i] positions
+   for Docs[i], one posting after the other).  'Buf' must have room for
+   PostBytes(Num, positions) bytes.  Returns the number of bytes. */
+long PostEncode(DOCID *Docs, POSTCOUNT *Tfs, POSTCOUNT *Where,
+                NUMPTRS Num, unsigned char *Buf) {
+    DOCID prev = 0;
+    long n = 0;
+    NUMPTRS i, j;
+
+    assert(!POSITIONS || (Where != NULL));
+    for (i = 0; i + BLOCKSIZE <= Num; i += BLOCKSIZE) {
+        n += BlockEncode(Docs + i, Tfs + i, Where, prev, Buf + n);
+        prev = Docs[i + BLOCKSIZE - 1];
+        if (POSITIONS)
+            for (j = i; j < i + BLOCKSIZE; j++)
+                Where += Tfs[j];
+    }
+    for (; i < Num; i++) {
+        assert((Docs[i] >= prev) && (Tfs[i] >= 1));
+        n += VarintPut(Buf + n, (unsigned long) (Docs[i] - prev));
+        n += VarintPut(Buf + n, (unsigned long) Tfs[i]);
+        if (POSITIONS) {
+            n += WhereEncode(Where, Tfs[i], Buf + n);
+            Where += Tfs[i];
+        }
+        prev = Docs[i];
+    }
+    return (n);
+}
+
+/* as PostDecode() below, for postings in the middle of a record: 'Buf' is
+   where a block, or the tail, starts, and 'Base' the document before
+   it (the Max of the block before, see PostSkips()) */
+DOCID PostDecodeAt(unsigned char *Buf, NUMPTRS Num, DOCID Base, DOCID *Docs,
+                   POSTCOUNT *Tfs, POSTCOUNT *Where) {
+    DOCID doc = Base;
+    unsigned long delta, tf;
+    NUMPTRS i;
+
+    assert((Where == NULL) || (POSITIONS && (Tfs != NULL)));
+    for (i = 0; i + BLOCKSIZE <= Num; i += BLOCKSIZE) {
+        Buf += BlockDecode(Buf, doc, Docs + i, (Tfs != NULL) ? Tfs + i : NULL,
+                           (Where != NULL) ? &Where : NULL);
+        doc = Docs[i + BLOCKSIZE - 1];
+    }
+    for (; i < Num; i++) {
+        Buf += VarintGet(Buf, &delta);
+        Buf += VarintGet(Buf, &tf);
+        Docs[i] = doc += (DOCID) delta;
+        if (Tfs != NULL)
+            Tfs[i] = (POSTCOUNT) tf;
+        if (POSITIONS) {
+            Buf += WhereDecode(Buf, (POSTCOUNT) tf, Where);
+            if (Where != NULL)
+                Where += tf;
+        }
+    }
+    return (doc);
+}
+
+/* decodes the 'Num' postings of 'Buf' into 'Docs', and their tfs into
+   'Tfs' unless it is NULL; 'Buf' must be followed by POSTSLACK bytes,
+   as PostRead() leaves.  With POSITIONS, the positions go to 'Where'
+   unless it is NULL, laid out as PostEncode() takes them; they need
+   the tfs, and at most as many entries as the record has bytes.
+   Returns the last document. */
+DOCID PostDecode(unsigned char *Buf, NUMPTRS Num, DOCID *Docs,
+                 POSTCOUNT *Tfs, POSTCOUNT *Where) {
+    return (PostDecodeAt(Buf, Num, 0, Docs, Tfs, Where));
+}
+
+/* the skip entries of a record with 'Num' postings encoded in 'Buf':
+   for each of its blocks, its Max in 'Max' and its offset in 'Off',
+   read off the block headers without decoding anything.  Off[b] for
+   the last b, the number of blocks, is where the tail starts.
+   Returns the number of blocks. */
+NUMPTRS PostSkips(unsigned char *Buf, NUMPTRS Num, DOCID *Max, long *Off) {
+    NUMPTRS b;
+    long off = 0;
+
+    for (b = 0; b < Num / BLOCKSIZE; b++) {
+        Off[b] = off;
+        memcpy(&Max[b], Buf + off, sizeof(DOCID));
+        off += BlockLen(Buf + off);
+    }
+    Off[b] = off;
+    return (b);
+}
+
+/* appends the posting ('Doc', 'Tf'), with the positions 'Where' if
+   POSITIONS, to the record encoded in 'Buf', as read by PostRead(),
+   and updates its header; 'Buf' needs PostBytes(1, Tf) bytes of room
+   past the POSTSLACK.  Only the tail of the record is decoded, and
+   NumBytes does not go down (see above).  Returns the offset of the
+   first byte of 'Buf' that changed. */
+long PostAppend(unsigned char *Buf, struct PostHdr *Hdr, DOCID Doc,
+                POSTCOUNT Tf, POSTCOUNT *Where) {
+    DOCID base, last, docs[BLOCKSIZE];
+    POSTCOUNT tfs[BLOCKSIZE], *where = NULL, *w;
+    unsigned long delta, tf;
+    long tail, off, changed, used = Hdr->NumBytes;
+    int i, ntail = Hdr->NumPtrs % BLOCKSIZE;
+
+    assert(!POSITIONS || (Where != NULL));
+    tail = TailOffset(Buf, Hdr->NumPtrs, &base);
+    for (last = base, off = tail, i = 0; i < ntail; i++) {
+        off += VarintGet(Buf + off, &delta);
+        off += VarintGet(Buf + off, &tf);
+        if (POSITIONS)
+            off += WhereDecode(Buf + off, (POSTCOUNT) tf, NULL);
+        last += (DOCID) delta;
+    }
+    assert((Doc >= last) && (Tf >= 1));
+    changed = off;
+    off += VarintPut(Buf + off, (unsigned long) (Doc - last));
+    off += VarintPut(Buf + off, (unsigned long) Tf);
+    if (POSITIONS)
+        off += WhereEncode(Where, Tf, Buf + off);
+    Hdr->NumPtrs++;
+    Hdr->NumBytes = max(off, used);
+    Hdr->MaxTf = max(Hdr->MaxTf, Tf);
+
+    if (ntail + 1 == BLOCKSIZE) { /* the tail is full: pack it */
+        if (POSITIONS) { /* at most one position per byte */
+            where = (POSTCOUNT *) malloc(sizeof(POSTCOUNT) * (off - tail));
+            ck_malloc(where, "where in PostAppend()");
+        }
+        for (w = where, last = base, off = tail, i = 0; i < BLOCKSIZE; i++) {
+            off += VarintGet(Buf + off, &delta);
+            off += VarintGet(Buf + off, &tf);
+            docs[i] = last += (DOCID) delta;
+            tfs[i] = (POSTCOUNT) tf;
+            if (POSITIONS) {
+                off += WhereDecode(Buf + off, tfs[i], w);
+                w += tfs[i];
+            }
+        }
+        off = tail + BlockEncode(docs, tfs, where, base, Buf + tail);
+        Hdr->NumBytes = max(off, used);
+        changed = tail;
+        free(where);
+    }
+    return (changed);
+}
+
+/* reads the header of the record at 'pptr' */
+void PostReadHdr(POSTINGSPTR pptr, struct PostHdr *Hdr) {
+    fseek(fppost, (long) pptr, 0);
+    fread(&Hdr->NumPtrs, sizeof(Hdr->NumPtrs), 1, fppost);
+    fread(&Hdr->NumBytes, sizeof(Hdr->NumBytes), 1, fppost);
+    fread(&Hdr->MaxTf, sizeof(Hdr->MaxTf), 1, fppost);
+}
+
+/* reads the record at 'pptr': its header, and its encoded postings,
+   returned in a buffer to be freed by the caller, with POSTSLACK more
+   bytes of room */
+unsigned char *PostRead(POSTINGSPTR pptr, struct PostHdr *Hdr) {
+    unsigned char *buf;
+
+    pReadCount++;
+    PostReadHdr(pptr, Hdr);
+    buf = (unsigned char *) malloc(Hdr->NumBytes + POSTSLACK);
+    ck_malloc(buf, "postings record");
+    fread(buf, 1, Hdr->NumBytes, fppost);
+    return (buf);
+}
+
+/* writes the header of the record at 'pptr', followed by 'Len' bytes
+   of encoded postings from 'Buf' (none if 'Len' is 0) */
+void PostWrite(POSTINGSPTR pptr, struct PostHdr *Hdr, unsigned char *Buf,
+               long Len) {
+    pWriteCount++;
+    fseek(fppost, (long) pptr, 0);
+    fwrite(&Hdr->NumPtrs, sizeof(Hdr->NumPtrs), 1, fppost);
+    fwrite(&Hdr->NumBytes, sizeof(Hdr->NumBytes), 1, fppost);
+    fwrite(&Hdr->MaxTf, sizeof(Hdr->MaxTf), 1, fppost);
+    if (Len > 0)
+        fwrite(Buf, 1, Len, fppost);
+}
@@ -4,18 +4,26 @@
       'fp'
    starting at
       'start'
-    with the TAG character.
+    with the TAG character, and
+      'size'
+    bytes long after it (see doctable.c).
  */
 
-void pr_msg(long int start, FILE *fp) {
+void pr_msg(long int start, long int size, FILE *fp) {
+    char buf[BUFSIZ];
+    long n;
     int c;
+
     fseek(fp, (long) start, 0);
     c = getc(fp);
     if (c != TAG) {
         printf("pr_msg: WARNING -");
         printf("document does not start with TAG at %ld\n", start);
     }
-    while (((c = getc(fp)) != TAG) && (c != EOF)) {
-        putchar(c);
+    for (; size > 0; size -= n) {
+        n = fread(buf, 1, min(size, (long) sizeof(buf)), fp);
+        if (n <= 0)
+            break;
+        fwrite(buf, 1, n, stdout);
     }
 }
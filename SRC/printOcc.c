@@ -8,15 +8,13 @@ modified for contiguious postings file  by Frank Andrasco
  */
 
 #include "def.h"
-extern FILE *fppost;
+
+extern void PostReadHdr(POSTINGSPTR pptr, struct PostHdr *Hdr);
 
 void printOcc(struct KeyRecord *p) {
-    POSTINGSPTR pptr;
-    NUMPTRS NumTextOffsets;
+    struct PostHdr hdr;
 
-    pptr = p->Posting;
-    fseek(fppost, (long) pptr, 0);
-    fread(&NumTextOffsets, sizeof(NumTextOffsets), 1, fppost);
+    PostReadHdr(p->Posting, &hdr); /* the count is in the header */
 
-    printf("%s:%d\n", p->StoredKey, (int) NumTextOffsets);
+    printf("%s:%d\n", p->StoredKey, (int) hdr.NumPtrs);
 }
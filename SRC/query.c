@@ -0,0 +1,386 @@
+/* query.c */
+
+/*  Boolean queries over several terms (command "Q"), e.g.
+
+        jean AND (pierre OR christophe) AND NOT paul
+
+    AND, OR and NOT are written in capitals; AND binds tighter than OR,
+    and two terms with no operator between them are ANDed.  Common
+    words are dropped from the query, as they are not indexed.  NOT may
+    only qualify a part of an AND that has some other, positive part:
+    there is no list of all the documents to take a complement from.
+
+    The query is parsed into a tree whose leaves are cursors over the
+    postings lists of the terms (postcursor.c), fetched through
+    treesearch().  It is then evaluated one document at a time, in the
+    order of the documents, by QSeek(): the first matching document
+    at or after a target.  An AND seeks its parts from the shortest one
+    up: the shortest list proposes a document, and each longer one
+    either confirms it or proposes a later document, which the shortest
+    list then seeks to, so the cursors of the long lists gallop over
+    most of their entries without reading them.  An OR takes the least
+    of the documents of its parts.
+*/
+
+#include "def.h"
+
+#define QTERM (0)
+#define QAND (1)
+#define QOR (2)
+#define MAXQTOKENS (MAXQUERYSIZE / 2) /* tokens in a query, at most */
+
+struct QNode {
+    int Op;       /* QTERM, QAND or QOR */
+    int Negated;  /* a part of an AND that must not match */
+    int NumKids;  /* parts of an AND or OR, the positive ones first */
+    struct QNode **Kids;
+    struct PostCursor Cursor; /* of a QTERM */
+    long Est;    /* documents it matches, at most */
+    DOCID Doc;   /* the last document found by QSeek() */
+};
+
+extern int sqCount, uqCount;
+
+extern int iscommon(char *word);
+extern int check_word(char *word);
+extern int strtolow(char *s);
+extern POSTINGSPTR treesearch(PAGENO PageNo, char *key);
+extern void DocPrint(DOCID Doc);
+extern void CursorOpen(struct PostCursor *C, POSTINGSPTR pptr, int Where);
+extern DOCID CursorSeek(struct PostCursor *C, DOCID Target);
+extern void CursorClose(struct PostCursor *C);
+
+static char *Tokens[MAXQTOKENS];
+static int NumTokens, Next; /* the tokens, and the next one to parse */
+static int QError;          /* the query is malformed */
+
+/* splits 'Line' in place into words and parentheses */
+static void Tokenize(char *Line) {
+    static char parens[2 * MAXQUERYSIZE];
+    char *p = Line, *q = parens;
+
+    NumTokens = 0;
+    while (*p != EOS) {
+        if (isspace((unsigned char) *p)) {
+            *p++ = EOS;
+            continue;
+        }
+        if (NumTokens == MAXQTOKENS) {
+            printf("query: more than %d words\n", MAXQTOKENS);
+            QError = TRUE;
+            return;
+        }
+        if ((*p == '(') || (*p == ')')) {
+            q[0] = *p;
+            q[1] = EOS;
+            Tokens[NumTokens++] = q;
+            q += 2;
+            *p++ = EOS;
+            continue;
+        }
+        Tokens[NumTokens++] = p;
+        while ((*p != EOS) && !isspace((unsigned char) *p) && (*p != '(') &&
+               (*p != ')'))
+            p++;
+        if ((*p == '(') || (*p == ')'))
+            continue; /* the word is terminated with the parenthesis */
+        if (*p != EOS)
+            *p++ = EOS;
+    }
+}
+
+static int IsToken(char *Word) {
+    return ((Next < NumTokens) && (strcmp(Tokens[Next], Word) == 0));
+}
+
+static struct QNode *NewNode(int Op) {
+    struct QNode *n = (struct QNode *) malloc(sizeof(struct QNode));
+
+    ck_malloc(n, "n");
+    n->Op = Op;
+    n->Negated = FALSE;
+    n->NumKids = 0;
+    n->Kids = NULL;
+    CursorOpen(&n->Cursor, NONEXISTENT, FALSE); /* empty, for now */
+    n->Est = 0;
+    n->Doc = -1;
+    return (n);
+}
+
+static void FreeNode(struct QNode *N) {
+    int i;
+
+    if (N == NULL)
+        return;
+    for (i = 0; i < N->NumKids; i++)
+        FreeNode(N->Kids[i]);
+    free(N->Kids);
+    CursorClose(&N->Cursor);
+    free(N);
+}
+
+/* adds the part 'Kid' to the AND or OR 'N', splicing in the parts of a
+   Kid of the same kind */
+static void AddKid(struct QNode *N, struct QNode *Kid) {
+    int i;
+
+    if (Kid == NULL) /* a dropped common word */
+        return;
+    if ((Kid->Op == N->Op) && !Kid->Negated) {
+        for (i = 0; i < Kid->NumKids; i++)
+            AddKid(N, Kid->Kids[i]);
+        Kid->NumKids = 0;
+        FreeNode(Kid);
+        return;
+    }
+    N->Kids = (struct QNode **) realloc(
+        N->Kids, sizeof(struct QNode *) * (N->NumKids + 1));
+    ck_malloc(N->Kids, "N->Kids");
+    N->Kids[N->NumKids++] = Kid;
+}
+
+/* an AND or OR of one part is that part; of none, nothing */
+static struct QNode *Collapse(struct QNode *N) {
+    struct QNode *kid;
+
+    if (N->NumKids > 1)
+        return (N);
+    kid = (N->NumKids == 1) ? N->Kids[0] : NULL;
+    N->NumKids = 0;
+    FreeNode(N);
+    return (kid);
+}
+
+/* a term: its postings, or NULL for a common word */
+static struct QNode *ParseTerm(void) {
+    char *word = Tokens[Next++];
+    struct QNode *n;
+
+    if (strlen(word) >= MAXWORDSIZE) {
+        printf("query: word too long: %.20s...\n", word);
+        QError = TRUE;
+        return (NULL);
+    }
+    if (iscommon(word)) {
+        printf("\"%s\" is a common word - dropped from the query\n", word);
+        return (NULL);
+    }
+    if (check_word(word) == FALSE) {
+        QError = TRUE;
+        return (NULL);
+    }
+    strtolow(word);
+
+    n = NewNode(QTERM);
+    CursorOpen(&n->Cursor, treesearch(ROOT, word), FALSE);
+    if (n->Cursor.Num == 0)
+        printf("key \"%s\": not found\n", word);
+    n->Est = n->Cursor.Num;
+    return (n);
+}
+
+static struct QNode *ParseOr(void);
+
+/* unary := NOT unary | ( or ) | term */
+static struct QNode *ParseUnary(void) {
+    struct QNode *n;
+
+    if (Next == NumTokens) {
+        printf("query: a word is missing at the end\n");
+        QError = TRUE;
+        return (NULL);
+    }
+    if (IsToken("NOT")) {
+        Next++;
+        n = ParseUnary();
+        if (n != NULL)
+            n->Negated = !n->Negated;
+        return (n);
+    }
+    if (IsToken("(")) {
+        Next++;
+        n = ParseOr();
+        if (!QError && !IsToken(")")) {
+            printf("query: a \")\" is missing\n");
+            QError = TRUE;
+        }
+        Next++;
+        return (n);
+    }
+    if (IsToken(")") || IsToken("AND") || IsToken("OR")) {
+        printf("query: a word is missing before \"%s\"\n", Tokens[Next]);
+        QError = TRUE;
+        return (NULL);
+    }
+    return (ParseTerm());
+}
+
+/* and := unary { [AND] unary } */
+static struct QNode *ParseAnd(void) {
+    struct QNode *n = NewNode(QAND);
+
+    AddKid(n, ParseUnary());
+    while (!QError && (Next < NumTokens) && !IsToken("OR") &&
+           !IsToken(")")) {
+        if (IsToken("AND"))
+            Next++;
+        AddKid(n, ParseUnary());
+    }
+    return (Collapse(n));
+}
+
+/* or := and { OR and } */
+static struct QNode *ParseOr(void) {
+    struct QNode *n = NewNode(QOR);
+
+    AddKid(n, ParseAnd());
+    while (!QError && IsToken("OR")) {
+        Next++;
+        AddKid(n, ParseAnd());
+    }
+    return (Collapse(n));
+}
+
+/* positive parts first, each kind from the fewest documents up */
+static int KidOrder(const void *a, const void *b) {
+    struct QNode *x = *(struct QNode **) a, *y = *(struct QNode **) b;
+
+    if (x->Negated != y->Negated)
+        return (x->Negated - y->Negated);
+    return ((x->Est > y->Est) - (x->Est < y->Est));
+}
+
+/* orders the parts of the ANDs, sets the estimates, and checks that
+   every NOT is a part of an AND with a positive part */
+static int Prepare(struct QNode *N) {
+    int i;
+
+    if (N->Op == QTERM)
+        return (TRUE);
+    for (i = 0; i < N->NumKids; i++) {
+        if (!Prepare(N->Kids[i]))
+            return (FALSE);
+        if (N->Kids[i]->Negated && (N->Op != QAND)) {
+            printf("query: NOT must be ANDed with a positive part\n");
+            return (FALSE);
+        }
+    }
+    if (N->Op == QOR) {
+        for (N->Est = 0, i = 0; i < N->NumKids; i++)
+            N->Est += N->Kids[i]->Est;
+        return (TRUE);
+    }
+    qsort(N->Kids, N->NumKids, sizeof(struct QNode *), KidOrder);
+    if (N->Kids[0]->Negated) {
+        printf("query: NOT must be ANDed with a positive part\n");
+        return (FALSE);
+    }
+    N->Est = N->Kids[0]->Est;
+    return (TRUE);
+}
+
+/* the first document >= 'Target' that matches 'N', or ENDOFLIST.
+   Targets never decrease, so a document found before still answers
+   any target up to it. */
+static DOCID QSeek(struct QNode *N, DOCID Target) {
+    DOCID d, e;
+    int i, npos;
+
+    if (N->Doc >= Target)
+        return (N->Doc);
+    switch (N->Op) {
+    case QTERM:
+        d = CursorSeek(&N->Cursor, Target);
+        break;
+    case QOR:
+        for (d = ENDOFLIST, i = 0; i < N->NumKids; i++)
+            d = min(d, QSeek(N->Kids[i], Target));
+        break;
+    default: /* QAND */
+        for (npos = 0; (npos < N->NumKids) && !N->Kids[npos]->Negated; npos++)
+            ;
+        d = Target;
+        for (;;) {
+            /* the shortest part proposes, the others confirm */
+            d = QSeek(N->Kids[0], d);
+            for (e = d, i = 1; (d != ENDOFLIST) && (i < npos); i++)
+                if ((e = QSeek(N->Kids[i], d)) != d)
+                    break;
+            if (d == ENDOFLIST)
+                break;
+            if (e != d) {
+                d = e;
+                continue;
+            }
+            for (i = npos; i < N->NumKids; i++)
+                if (QSeek(N->Kids[i], d) == d)
+                    break;
+            if (i == N->NumKids)
+                break; /* no NOT part has it */
+            d++;
+        }
+        break;
+    }
+    return (N->Doc = d);
+}
+
+/* reads the query: the rest of the command line, or the next line
+   that is not blank.  Returns FALSE at the end of the input. */
+int readquery(char *Line) {
+    int len, c;
+
+    do {
+        if (fgets(Line, MAXQUERYSIZE, stdin) == NULL)
+            return (FALSE);
+        len = strlen(Line);
+        if ((len == MAXQUERYSIZE - 1) && (Line[len - 1] != '\n')) {
+            printf("query: longer than %d characters, cut\n",
+                   MAXQUERYSIZE - 2);
+            while (((c = getchar()) != '\n') && (c != EOF))
+                ;
+        }
+        if ((len > 0) && (Line[len - 1] == '\n'))
+            Line[--len] = EOS;
+        len = strspn(Line, " \t\r");
+    } while (Line[len] == EOS);
+    memmove(Line, Line + len, strlen(Line + len) + 1);
+    return (TRUE);
+}
+
+/* evaluates the query 'Line', and prints the documents that match */
+void query(char *Line) {
+    struct QNode *root;
+    int docCount = 0;
+    DOCID d;
+
+    QError = FALSE;
+    Next = 0;
+    Tokenize(Line);
+    root = QError ? NULL : ParseOr();
+    if (!QError && (Next < NumTokens)) {
+        printf("query: unexpected \"%s\"\n", Tokens[Next]);
+        QError = TRUE;
+    }
+    if (!QError && (root == NULL))
+        printf("query: nothing to search for\n");
+    else if (!QError && root->Negated) {
+        printf("query: NOT must be ANDed with a positive part\n");
+        QError = TRUE;
+    } else if (!QError && !Prepare(root))
+        QError = TRUE;
+    if (QError || (root == NULL)) {
+        FreeNode(root);
+        return;
+    }
+
+    for (d = QSeek(root, 0); d != ENDOFLIST; d = QSeek(root, d + 1)) {
+        printf("-------document #%d-----\n", ++docCount);
+        DocPrint(d);
+    }
+    printf("\n%d document(s) match\n", docCount);
+    if (docCount > 0)
+        sqCount++;
+    else
+        uqCount++;
+    FreeNode(root);
+}
@@ -0,0 +1,254 @@
+/* rank.c */
+
+/*  Ranked retrieval (command "R"): the k documents that score best for
+    a list of words, by BM25:
+
+        score(d) = sum, over the words t in d, of
+                   idf(t) * tf * (K1 + 1) / (tf + K1 * norm(d))
+        norm(d)  = 1 - B + B * len(d) / avglen
+        idf(t)   = log(1 + (N - df + 0.5) / (df + 0.5))
+
+    where tf is the frequency of t in d (postrec.c), df the number of
+    documents with t, N the number of documents, and len(d) the length
+    of d, and avglen the average one (doctable.c).  Ties go to the
+    earlier document.
+
+    The documents are visited in increasing order, with WAND
+    ("weak AND"): every word has an upper bound on what it adds to a
+    score, for its largest tf (kept in the header of its postings
+    record) in a document of length 0.  The best k documents so far
+    are kept in a heap, whose worst score is the threshold a new
+    document must beat.  With the cursors sorted by their current
+    document, the pivot is the first cursor where the bounds of the
+    cursors up to it add up to more than the threshold: no document
+    before the pivot's can make it into the heap, so the cursors before
+    the pivot seek straight to its document (CursorSeek(), see
+    postcursor.c), and a document is scored only when enough of the
+    words are in it.  The postings of the frequent words, whose bounds
+    are low, are mostly skipped rather than scored.
+*/
+
+#include "def.h"
+#include <math.h>
+
+#define BM25K1 (1.2)
+#define BM25B (0.75)
+#define MAXRANKWORDS (64) /* words in a ranked query, at most */
+
+struct RankWord {
+    char Word[MAXWORDSIZE];
+    struct PostCursor Cursor;
+    double Idf;
+    double Bound; /* the most it adds to the score of a document */
+};
+
+struct Hit {
+    DOCID Doc;
+    double Score;
+};
+
+extern int sqCount, uqCount;
+
+extern int iscommon(char *word);
+extern int check_word(char *word);
+extern int strtolow(char *s);
+extern POSTINGSPTR treesearch(PAGENO PageNo, char *key);
+extern void DocPrint(DOCID Doc);
+extern void CursorOpen(struct PostCursor *C, POSTINGSPTR pptr, int Where);
+extern DOCID CursorDoc(struct PostCursor *C);
+extern DOCID CursorSeek(struct PostCursor *C, DOCID Target);
+extern POSTCOUNT CursorTf(struct PostCursor *C);
+extern void CursorClose(struct PostCursor *C);
+extern long DocLen(DOCID Doc);
+extern long DocCount(void);
+extern double DocAvgLen(void);
+
+static struct RankWord Words[MAXRANKWORDS];
+static int NumWords;
+
+/* TRUE if hit 'a' ranks below hit 'b' */
+static int Worse(struct Hit *a, struct Hit *b) {
+    return ((a->Score < b->Score) ||
+            ((a->Score == b->Score) && (a->Doc > b->Doc)));
+}
+
+/* restores the order of the heap of 'n' hits below Heap[i]: the worst
+   hit is on top */
+static void HitDown(struct Hit *Heap, int n, int i) {
+    struct Hit t;
+    int c;
+
+    while ((c = 2 * i + 1) < n) {
+        if ((c + 1 < n) && Worse(&Heap[c + 1], &Heap[c]))
+            c++;
+        if (!Worse(&Heap[c], &Heap[i]))
+            break;
+        t = Heap[i];
+        Heap[i] = Heap[c];
+        Heap[c] = t;
+        i = c;
+    }
+}
+
+/* adds the hit 'h' to the heap of *n hits, keeping the best 'k' */
+static void HitAdd(struct Hit *Heap, int *n, int k, struct Hit *h) {
+    int i, p;
+
+    if (*n == k) {
+        if (!Worse(&Heap[0], h))
+            return;
+        Heap[0] = *h;
+        HitDown(Heap, *n, 0);
+        return;
+    }
+    for (i = (*n)++; (i > 0) && Worse(h, &Heap[p = (i - 1) / 2]); i = p)
+        Heap[i] = Heap[p];
+    Heap[i] = *h;
+}
+
+/* orders hits from the best down */
+static int HitOrder(const void *a, const void *b) {
+    return (Worse((struct Hit *) a, (struct Hit *) b) -
+            Worse((struct Hit *) b, (struct Hit *) a));
+}
+
+/* what the word 'w' adds to the score of a document where it occurs
+   'Tf' times, with length normalization 'Norm' */
+static double WordScore(struct RankWord *w, POSTCOUNT Tf, double Norm) {
+    return (w->Idf * Tf * (BM25K1 + 1) / (Tf + BM25K1 * Norm));
+}
+
+/* looks up the words of 'Line'; FALSE if there is none to rank by */
+static int RankWords(char *Line) {
+    static char *blanks = " \t\r\n";
+    char *word;
+    double N = DocCount(), df;
+    int i;
+
+    NumWords = 0;
+    for (word = strtok(Line, blanks); word != NULL;
+         word = strtok(NULL, blanks)) {
+        if (strlen(word) >= MAXWORDSIZE) {
+            printf("rank: word too long: %.20s...\n", word);
+            continue;
+        }
+        if (iscommon(word)) {
+            printf("\"%s\" is a common word - dropped from the query\n", word);
+            continue;
+        }
+        if (check_word(word) == FALSE)
+            continue;
+        strtolow(word);
+        for (i = 0; i < NumWords; i++)
+            if (strcmp(Words[i].Word, word) == 0)
+                break;
+        if (i < NumWords) /* each word counts once */
+            continue;
+        if (NumWords == MAXRANKWORDS) {
+            printf("rank: more than %d words\n", MAXRANKWORDS);
+            break;
+        }
+
+        strcpy(Words[NumWords].Word, word);
+        CursorOpen(&Words[NumWords].Cursor, treesearch(ROOT, word), FALSE);
+        if (Words[NumWords].Cursor.Num == 0) {
+            printf("key \"%s\": not found\n", word);
+            CursorClose(&Words[NumWords].Cursor);
+            continue;
+        }
+        df = Words[NumWords].Cursor.Num;
+        Words[NumWords].Idf = log(1 + (N - df + 0.5) / (df + 0.5));
+        Words[NumWords].Bound = WordScore(&Words[NumWords],
+                                          Words[NumWords].Cursor.MaxTf,
+                                          1 - BM25B);
+        NumWords++;
+    }
+    return (NumWords > 0);
+}
+
+/* prints the 'k' documents that rank best for the words of 'Line' */
+void rank(char *Line, int k) {
+    struct RankWord *order[MAXRANKWORDS], *t;
+    struct Hit *heap, h;
+    int nheap = 0, p, i, j;
+    double acc, theta, avglen = DocAvgLen(), norm;
+    long len, scored = 0, total = 0;
+    DOCID d;
+
+    if (k <= 0) {
+        printf("rank: k must be positive\n");
+        return;
+    }
+    if (!RankWords(Line)) {
+        printf("rank: nothing to search for\n");
+        return;
+    }
+    heap = (struct Hit *) malloc(sizeof(struct Hit) * k);
+    ck_malloc(heap, "heap in rank()");
+    for (i = 0; i < NumWords; i++) {
+        order[i] = &Words[i];
+        total += Words[i].Cursor.Num;
+    }
+
+    for (;;) {
+        /* the cursors by current document (insertion sort: they are
+           few, and mostly in order already) */
+        for (i = 1; i < NumWords; i++) {
+            t = order[i];
+            d = CursorDoc(&t->Cursor);
+            for (j = i; (j > 0) && (CursorDoc(&order[j - 1]->Cursor) > d);
+                 j--)
+                order[j] = order[j - 1];
+            order[j] = t;
+        }
+
+        /* the pivot: the first cursor where the bounds exceed theta */
+        theta = (nheap < k) ? -1.0 : heap[0].Score;
+        for (acc = 0, p = 0; p < NumWords; p++) {
+            if (CursorDoc(&order[p]->Cursor) == ENDOFLIST)
+                break;
+            acc += order[p]->Bound;
+            if (acc > theta)
+                break;
+        }
+        if ((p == NumWords) || (CursorDoc(&order[p]->Cursor) == ENDOFLIST))
+            break; /* no document left can make it */
+        d = CursorDoc(&order[p]->Cursor);
+
+        if (CursorDoc(&order[0]->Cursor) != d) {
+            /* nothing before d can make it: skip to d */
+            for (i = 0; i < p; i++)
+                CursorSeek(&order[i]->Cursor, d);
+            continue;
+        }
+
+        /* every cursor up to the pivot is on d: score it */
+        len = DocLen(d);
+        norm = 1 - BM25B + BM25B * len / avglen;
+        h.Doc = d;
+        h.Score = 0;
+        for (i = 0; (i < NumWords) && (CursorDoc(&order[i]->Cursor) == d);
+             i++) {
+            h.Score += WordScore(order[i], CursorTf(&order[i]->Cursor), norm);
+            CursorSeek(&order[i]->Cursor, d + 1);
+            scored++;
+        }
+        HitAdd(heap, &nheap, k, &h);
+    }
+
+    qsort(heap, nheap, sizeof(struct Hit), HitOrder);
+    for (i = 0; i < nheap; i++) {
+        printf("-------document #%d, score %.4f-----\n", i + 1, heap[i].Score);
+        DocPrint(heap[i].Doc);
+    }
+    printf("\n%d document(s) ranked; %ld of %ld postings scored\n", nheap,
+           scored, total);
+    if (nheap > 0)
+        sqCount++;
+    else
+        uqCount++;
+
+    free(heap);
+    for (i = 0; i < NumWords; i++)
+        CursorClose(&Words[i].Cursor);
+}
@@ -1,17 +1,31 @@
 /*
-    Applies function "f" to every key in page "p"
+    Applies function "f" to every key in page image "p".
+    The keys are handed to "f" one at a time, in a KeyRecord
+    that lives on the stack - no list is built.
  */
 #include "def.h"
 
 typedef void (*RecordVisitor)(struct KeyRecord *);
 
-void scanLeaf(struct PageHdr *p, RecordVisitor f) {
-    struct KeyRecord *keyptr;
+extern int SlotNumKeys(char *Page);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern long SlotPtr(char *Page, int i);
+
+void scanLeaf(char *p, RecordVisitor f) {
+    struct KeyRecord key;
+    char word[MAXWORDSIZE + 1];
+    char *w;
+    int i;
+
+    key.StoredKey = word;
+    key.Next = NULL;
 
     /* traverse all keys in this page */
-    keyptr = p->KeyListPtr;
-    while (keyptr != NULL) {
-        f(keyptr);
-        keyptr = keyptr->Next;
+    for (i = 0; i < SlotNumKeys(p); i++) {
+        w = SlotKey(p, i, &key.KeyLen);
+        memcpy(word, w, key.KeyLen);
+        word[key.KeyLen] = '\0';
+        key.Posting = SlotPtr(p, i);
+        f(&key);
     }
 }
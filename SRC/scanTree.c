@@ -1,34 +1,38 @@
 /*
      Scans all the entries of the B-tree, applying
-     the function "f" for each entry
+     the function "f" for each entry.
+     The pages are scanned in place, in the buffer pool.
  */
 
 #include "def.h"
 
-extern FILE *fpbtree;
-
 typedef void (*RecordVisitor)(struct KeyRecord *);
 
-extern int FreePage(struct PageHdr *PagePtr);
-extern void scanLeaf(struct PageHdr *p, RecordVisitor f);
+extern void scanLeaf(char *Page, RecordVisitor f);
+extern char *PinPage(PAGENO Page, int *pFrame);
+extern void BufUnpin(int f, int Dirty);
+extern long SlotPtr(char *Page, int i);
+extern PAGENO SlotLink(char *Page);
 
 void scanTree(RecordVisitor f) {
-    struct PageHdr *FetchPage(PAGENO Page), *p, *tempp;
+    int Frame, tempFrame;
+    char *p;
 
-    p = FetchPage(ROOT);
+    p = PinPage(ROOT, &Frame);
 
-    while (IsNonLeaf(p)) { /* follow leftmost ptr */
-        tempp = p;
-        p = FetchPage((tempp->KeyListPtr)->PgNum);
-        FreePage(tempp);
+    while (IsNonLeafImage(p)) { /* follow leftmost ptr */
+        tempFrame = Frame;
+        p = PinPage(SlotPtr(p, 0), &Frame);
+        BufUnpin(tempFrame, FALSE);
     }
 
     /* now "p" should point to the alphabetically first page */
     scanLeaf(p, f);
-    while ((p->PgNumOfNxtLfPg) != NULLPAGENO) { /* get next valid page */
-        tempp = p;
-        p = FetchPage(tempp->PgNumOfNxtLfPg);
-        FreePage(tempp);
+    while (SlotLink(p) != NULLPAGENO) { /* get next valid page */
+        tempFrame = Frame;
+        p = PinPage(SlotLink(p), &Frame);
+        BufUnpin(tempFrame, FALSE);
         scanLeaf(p, f); /* and process it */
     }
+    BufUnpin(Frame, FALSE);
 }
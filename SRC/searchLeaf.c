@@ -1,6 +1,6 @@
 /*
-    searches the leaf at the node stored at the page with number
-        PageNo
+    searches the leaf page image
+        Page
     for the
         key.
     It returns the offset from the postings file, or NONEXISTENT,
@@ -9,27 +9,23 @@
 
 #include "def.h"
 
-POSTINGSPTR searchLeaf(struct PageHdr *PagePtr, char *key) {
+extern int SlotSearch(char *Page, char *Key, int KeyLen, int *Found);
+extern char *SlotKey(char *Page, int i, int *Len);
+extern long SlotPtr(char *Page, int i);
 
-    struct KeyRecord *KeyListTraverser;
-    int InsertionPosition; /* Position for insertion */
-    int FindInsertionPosition(struct KeyRecord * KeyListTraverser, char *Key,
-                              int *Found, NUMKEYS NumKeys, int Count);
-    int Count, Found, i;
+POSTINGSPTR searchLeaf(char *Page, char *key) {
+    int Position; /* Position of the key in the page */
+    int Found, Len;
+    char *Word;
 
-    Count = 0;
-
-    /* Find insertion position */
-    KeyListTraverser = PagePtr->KeyListPtr;
-    InsertionPosition = FindInsertionPosition(KeyListTraverser, key, &Found,
-                                              PagePtr->NumKeys, Count);
+    /* Find the key by binary search over the slot array */
+    Position = SlotSearch(Page, key, strlen(key), &Found);
 
     /* key is already in the B-Tree */
     if (Found == TRUE) {
-        for (i = 0; i < InsertionPosition - 1; i++)
-            KeyListTraverser = KeyListTraverser->Next;
-        printf("found in %s\n", KeyListTraverser->StoredKey);
-        return (KeyListTraverser->Posting);
+        Word = SlotKey(Page, Position, &Len);
+        printf("found in %.*s\n", Len, Word);
+        return (SlotPtr(Page, Position));
     } else {
         return (NONEXISTENT);
     }
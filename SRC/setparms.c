@@ -2,17 +2,40 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 int PAGESIZE;
 int MAXTEXTPTRS;
+int POOLSIZE = 256; /* default, unless "parms" says otherwise */
+int MMAPMODE = 0;   /* the B-tree file is read with fread() by default */
+int SORTMEM = 65536; /* kilobytes of (word, document) pairs the bulk
+                       loader sorts in memory */
+int POSITIONS = 0;   /* the postings keep no word positions by default */
+int BATCHMEM = 16384; /* kilobytes of new postings that the insertions
+                        collect before they update the index */
+int THREADS = 0;      /* threads of "I": one per processor by default */
 double GF;
 
 extern long LISTSIZE[100];
 
+/* "parms" holds the page size and the growth factor, optionally
+   followed by lines of the form "name value":
+        poolsize 1024   frames of the buffer pool
+        mmap 1          maps the B-tree file into memory
+        sortmem 1024    kilobytes of memory of the bulk loader
+        positions 1     a new index keeps the positions of the words,
+                        for phrase queries
+        batchmem 1024   kilobytes of postings that the insertions
+                        collect (see accum.c); 0 updates at once
+        threads 4       threads that read the files of "I", or the
+                        documents of "r" (see ingest.c) */
+
 void setparms(void) {
     FILE *fp;
     double gf; /* growth factor */
     int i;
+    char name[100];
+    long value;
 
     fp = fopen("parms", "r");
     if (fp == NULL) {
@@ -21,7 +44,28 @@ void setparms(void) {
     }
 
     fscanf(fp, "%d %lf", &PAGESIZE, &gf);
+    while (fscanf(fp, "%99s %ld", name, &value) == 2) {
+        if (strcmp(name, "poolsize") == 0)
+            POOLSIZE = (int) value;
+        else if (strcmp(name, "mmap") == 0)
+            MMAPMODE = (value != 0);
+        else if (strcmp(name, "sortmem") == 0)
+            SORTMEM = (int) value;
+        else if (strcmp(name, "positions") == 0)
+            POSITIONS = (value != 0);
+        else if (strcmp(name, "batchmem") == 0)
+            BATCHMEM = (int) value;
+        else if (strcmp(name, "threads") == 0)
+            THREADS = (int) value;
+        else
+            printf("parms: unknown parameter \"%s\" ignored\n", name);
+    }
     fclose(fp);
+    assert(POOLSIZE > 0);
+    assert(SORTMEM > 0);
+    assert(BATCHMEM >= 0);
+    assert(THREADS >= 0);
+    assert(PAGESIZE < 65536); /* slot offsets are unsigned shorts */
     MAXTEXTPTRS = 1; /* to be deleted?*/
     GF = gf;
     assert(gf >= 1.5);
@@ -0,0 +1,418 @@
+/* slotpage.c */
+
+/*  Routines that work directly on the binary image of a B-tree page,
+    as it sits in its buffer-pool frame, without building the list of
+    KeyRecord structures.
+
+    Every page starts with the same header (offsets in bytes):
+
+        SP_TYPE  (0)    PgTypeID, 'L' or 'N'
+        SP_NKEYS (2)    number of keys (unsigned short)
+        SP_HEAP  (4)    see below
+        SP_PGNUM (8)    page number of the page itself
+        SP_LINK  (16)   PgNumOfNxtLfPg (leaf) or PtrToFinalRtgPg (nonleaf)
+
+    A nonleaf page is a slotted page:
+
+        SP_SLOTS (24)   the slot array: one offset (SLOT) per key,
+                        in lexicographic order of the keys
+        ...             free space
+        key heap        grows downwards from the end of the page;
+                        SP_HEAP is the offset of its first byte
+
+    Each entry of the key heap holds
+        a pointer       PgNum of the left child, PAGENO bytes
+        KeyLen          one byte
+        the key         KeyLen bytes, not terminated
+
+    A leaf page front-codes its keys, which share long prefixes in
+    sorted order ("compute", "computer", "computing"):
+
+        SP_SLOTS (24)   the entries, in lexicographic order of the keys
+        ...             free space; SP_HEAP is the offset of its first byte
+        restarts        one SLOT per LEAFRESTART keys, growing downwards
+                        from the end of the page: the offset of the
+                        entry of key 0, LEAFRESTART, 2 * LEAFRESTART, ...
+
+    Each entry holds
+        a pointer       Posting offset, POSTINGSPTR bytes
+        Shared          one byte: bytes shared with the previous key,
+                        always 0 at a restart point
+        SuffixLen       one byte
+        the suffix      the remaining SuffixLen bytes of the key
+
+    Keys at restart points are stored in full, so searching is a binary
+    search over the restart points followed by a scan of at most
+    LEAFRESTART entries; in a nonleaf page it is a binary search over
+    the slot array.  Keys are compared with SlotCompare(), by memcmp()
+    and their stored lengths.
+    Appending a key writes one entry; inserting a key elsewhere in a
+    leaf re-encodes the page.
+*/
+
+#include "def.h"
+
+extern int KeyShared(char *Key, int KeyLen, char *Word, int WordLen);
+
+/* offsets within a leaf entry */
+#define LE_SHARED (sizeof(POSTINGSPTR))
+#define LE_SUFFIXLEN (sizeof(POSTINGSPTR) + 1)
+#define LE_SUFFIX (sizeof(POSTINGSPTR) + 2)
+
+/* a position in a leaf page, with the key there decoded */
+struct LeafCursor {
+    int Pos;                   /* number of the key */
+    SLOT Off;                  /* offset of its entry */
+    int Len;                   /* the key, in Key[0..Len-1] */
+    char Key[MAXWORDSIZE + 1]; /* terminated, for convenience */
+};
+
+static char LeafKey[MAXWORDSIZE + 1]; /* returned by SlotKey() for leaves */
+static char *Scratch = NULL;          /* a page image, to re-encode leaves */
+
+/* compares the key (Key, KeyLen) with the stored key (Word, WordLen);
+   returns <0, 0 or >0, as strcmp() does */
+int SlotCompare(char *Key, int KeyLen, char *Word, int WordLen) {
+    int res;
+
+    res = memcmp(Key, Word, min(KeyLen, WordLen));
+    if (res != 0)
+        return (res);
+    return (KeyLen - WordLen);
+}
+
+/* initializes an empty page */
+void SlotInit(char *Page, char Type, PAGENO PgNum, PAGENO Link) {
+    SLOT heap = (Type == LeafSymbol) ? (SLOT) SP_SLOTS : (SLOT) PAGESIZE;
+    SLOT nkeys = 0;
+
+    memset(Page, 0, SP_SLOTS);
+    Page[SP_TYPE] = Type;
+    memcpy(Page + SP_NKEYS, &nkeys, sizeof(nkeys));
+    memcpy(Page + SP_HEAP, &heap, sizeof(heap));
+    memcpy(Page + SP_PGNUM, &PgNum, sizeof(PgNum));
+    memcpy(Page + SP_LINK, &Link, sizeof(Link));
+}
+
+int SlotNumKeys(char *Page) {
+    SLOT nkeys;
+
+    memcpy(&nkeys, Page + SP_NKEYS, sizeof(nkeys));
+    return ((int) nkeys);
+}
+
+PAGENO SlotPgNum(char *Page) {
+    PAGENO pgnum;
+
+    memcpy(&pgnum, Page + SP_PGNUM, sizeof(pgnum));
+    return (pgnum);
+}
+
+/* next leaf (leaf pages) or rightmost child (nonleaf pages) */
+PAGENO SlotLink(char *Page) {
+    PAGENO link;
+
+    memcpy(&link, Page + SP_LINK, sizeof(link));
+    return (link);
+}
+
+void SlotSetLink(char *Page, PAGENO Link) {
+    memcpy(Page + SP_LINK, &Link, sizeof(Link));
+}
+
+/* returns the offset of the i-th entry of the key heap (nonleaf) */
+static SLOT SlotEntry(char *Page, int i) {
+    SLOT off;
+
+    memcpy(&off, Page + SP_SLOTS + i * sizeof(SLOT), sizeof(off));
+    return (off);
+}
+
+/* number of restart points of a leaf with 'NumKeys' keys */
+#define NumRestarts(NumKeys) (((NumKeys) + LEAFRESTART - 1) / LEAFRESTART)
+
+/* returns the offset of the entry at restart point r of a leaf */
+static SLOT LeafRestart(char *Page, int r) {
+    SLOT off;
+
+    memcpy(&off, Page + PAGESIZE - (r + 1) * sizeof(SLOT), sizeof(off));
+    return (off);
+}
+
+/* places the cursor on the key at restart point r */
+static void LeafSeek(char *Page, int r, struct LeafCursor *c) {
+    c->Pos = r * LEAFRESTART;
+    c->Off = LeafRestart(Page, r);
+    c->Len = (unsigned char) Page[c->Off + LE_SUFFIXLEN];
+    memcpy(c->Key, Page + c->Off + LE_SUFFIX, c->Len);
+    c->Key[c->Len] = EOS;
+}
+
+/* moves the cursor to the next key, which must exist */
+static void LeafNext(char *Page, struct LeafCursor *c) {
+    int shared, suffix;
+
+    c->Off += LE_SUFFIX + (unsigned char) Page[c->Off + LE_SUFFIXLEN];
+    c->Pos++;
+    shared = (unsigned char) Page[c->Off + LE_SHARED];
+    suffix = (unsigned char) Page[c->Off + LE_SUFFIXLEN];
+    memcpy(c->Key + shared, Page + c->Off + LE_SUFFIX, suffix);
+    c->Len = shared + suffix;
+    c->Key[c->Len] = EOS;
+}
+
+/* places the cursor on key i of a leaf */
+static void LeafFind(char *Page, int i, struct LeafCursor *c) {
+    LeafSeek(Page, i / LEAFRESTART, c);
+    while (c->Pos < i)
+        LeafNext(Page, c);
+}
+
+/* returns the offset of the entry of key i of a leaf, without
+   decoding the keys on the way */
+static SLOT LeafEntry(char *Page, int i) {
+    SLOT off = LeafRestart(Page, i / LEAFRESTART);
+
+    for (i %= LEAFRESTART; i > 0; i--)
+        off += LE_SUFFIX + (unsigned char) Page[off + LE_SUFFIXLEN];
+    return (off);
+}
+
+/* returns a pointer to the (unterminated) i-th key and its length.
+   The key of a leaf is decoded into a static buffer, which the next
+   call overwrites. */
+char *SlotKey(char *Page, int i, int *Len) {
+    struct LeafCursor c;
+    char *entry;
+
+    if (IsLeafImage(Page)) {
+        LeafFind(Page, i, &c);
+        memcpy(LeafKey, c.Key, c.Len + 1);
+        *Len = c.Len;
+        return (LeafKey);
+    }
+    entry = Page + SlotEntry(Page, i);
+    *Len = (unsigned char) entry[sizeof(long)];
+    return (entry + sizeof(long) + 1);
+}
+
+/* the child page number (nonleaf) or posting offset (leaf) of key i */
+long SlotPtr(char *Page, int i) {
+    long ptr;
+    SLOT off = IsLeafImage(Page) ? LeafEntry(Page, i) : SlotEntry(Page, i);
+
+    memcpy(&ptr, Page + off, sizeof(ptr));
+    return (ptr);
+}
+
+void SlotSetPtr(char *Page, int i, long Ptr) {
+    SLOT off = IsLeafImage(Page) ? LeafEntry(Page, i) : SlotEntry(Page, i);
+
+    memcpy(Page + off, &Ptr, sizeof(Ptr));
+}
+
+/* returns the number of bytes occupied in the page */
+int SlotBytes(char *Page) {
+    SLOT heap;
+    int nkeys = SlotNumKeys(Page);
+
+    memcpy(&heap, Page + SP_HEAP, sizeof(heap));
+    if (IsLeafImage(Page))
+        return (heap + NumRestarts(nkeys) * sizeof(SLOT));
+    return (SP_SLOTS + nkeys * sizeof(SLOT) + PAGESIZE - heap);
+}
+
+/* bytes taken in a leaf by the key (Key, KeyLen) as its i-th key,
+   after the key (Prev, PrevLen) */
+int SlotLeafBytes(int i, char *Prev, int PrevLen, char *Key, int KeyLen) {
+    if (i % LEAFRESTART == 0)
+        return (sizeof(SLOT) + LeafEntrySize(KeyLen));
+    return (LeafEntrySize(KeyLen - KeyShared(Key, KeyLen, Prev, PrevLen)));
+}
+
+/* the longest key the tree takes: two of them, with their restart
+   slots, fit in a leaf, and three in a nonleaf, so that a page that
+   overflows can always be split with keys on both sides */
+int SlotMaxKeyLen(void) {
+    int leaf = (PAGESIZE - SP_SLOTS) / 2 - (int) (sizeof(SLOT) +
+                                                  LeafEntrySize(0));
+    int nonleaf = (PAGESIZE - SP_SLOTS) / 3 - (int) SlotSize(0);
+
+    return (min(min(leaf, nonleaf), 255)); /* a one-byte length */
+}
+
+/* returns the number of bytes the page would occupy with the key
+   (Key, KeyLen) appended after its last key */
+int SlotAppendBytes(char *Page, char *Key, int KeyLen) {
+    struct LeafCursor c;
+    int nkeys = SlotNumKeys(Page);
+
+    if (!IsLeafImage(Page))
+        return (SlotBytes(Page) + SlotSize(KeyLen));
+    if (nkeys % LEAFRESTART == 0)
+        return (SlotBytes(Page) + SlotLeafBytes(nkeys, NULL, 0, Key, KeyLen));
+    LeafFind(Page, nkeys - 1, &c);
+    return (SlotBytes(Page) + SlotLeafBytes(nkeys, c.Key, c.Len, Key, KeyLen));
+}
+
+/* binary search for 'Key': returns the position of the first key
+   that is >= 'Key' (NumKeys if there is none), and sets *Found */
+int SlotSearch(char *Page, char *Key, int KeyLen, int *Found) {
+    int low, high, mid, res, len, end;
+    char *word;
+    struct LeafCursor c;
+
+    *Found = FALSE;
+    if (IsLeafImage(Page)) {
+        /* the first restart point whose key is >= 'Key' ... */
+        low = 0;
+        high = NumRestarts(SlotNumKeys(Page));
+        while (low < high) {
+            mid = (low + high) / 2;
+            word = Page + LeafRestart(Page, mid);
+            len = (unsigned char) word[LE_SUFFIXLEN];
+            word += LE_SUFFIX;
+            res = SlotCompare(Key, KeyLen, word, len);
+            if (res > 0)
+                low = mid + 1;
+            else {
+                if (res == 0) {
+                    *Found = TRUE;
+                    return (mid * LEAFRESTART);
+                }
+                high = mid;
+            }
+        }
+        if (low == 0)
+            return (0);
+        /* ... so the key is in the run of keys before it */
+        end = min(low * LEAFRESTART, SlotNumKeys(Page));
+        for (LeafSeek(Page, low - 1, &c);; LeafNext(Page, &c)) {
+            res = SlotCompare(Key, KeyLen, c.Key, c.Len);
+            if (res <= 0) {
+                *Found = (res == 0);
+                return (c.Pos);
+            }
+            if (c.Pos + 1 == end)
+                return (end);
+        }
+    }
+
+    low = 0;
+    high = SlotNumKeys(Page);
+    while (low < high) {
+        mid = (low + high) / 2;
+        word = SlotKey(Page, mid, &len);
+        res = SlotCompare(Key, KeyLen, word, len);
+        if (res > 0)
+            low = mid + 1;
+        else {
+            if (res == 0)
+                *Found = TRUE;
+            high = mid;
+        }
+    }
+    return (low);
+}
+
+/* appends the key (Key, KeyLen) with posting 'Ptr' to a leaf, after
+   the key (Prev, PrevLen), its last one.  Returns FALSE, leaving the
+   page untouched, if it does not fit. */
+static int LeafAppend(char *Page, char *Prev, int PrevLen, char *Key,
+                      int KeyLen, long Ptr) {
+    SLOT heap, nkeys = (SLOT) SlotNumKeys(Page);
+    int shared = 0;
+
+    if (SlotBytes(Page) + SlotLeafBytes(nkeys, Prev, PrevLen, Key, KeyLen) >
+        PAGESIZE)
+        return (FALSE);
+    if (nkeys % LEAFRESTART != 0)
+        shared = KeyShared(Key, KeyLen, Prev, PrevLen);
+
+    memcpy(&heap, Page + SP_HEAP, sizeof(heap));
+    memcpy(Page + heap, &Ptr, sizeof(Ptr));
+    Page[heap + LE_SHARED] = (char) shared;
+    Page[heap + LE_SUFFIXLEN] = (char) (KeyLen - shared);
+    memcpy(Page + heap + LE_SUFFIX, Key + shared, KeyLen - shared);
+    if (nkeys % LEAFRESTART == 0) /* a new restart point */
+        memcpy(Page + PAGESIZE - (NumRestarts(nkeys) + 1) * sizeof(SLOT),
+               &heap, sizeof(heap));
+
+    heap += LeafEntrySize(KeyLen - shared);
+    nkeys++;
+    memcpy(Page + SP_NKEYS, &nkeys, sizeof(nkeys));
+    memcpy(Page + SP_HEAP, &heap, sizeof(heap));
+    return (TRUE);
+}
+
+/* inserts the key (Key, KeyLen) with posting 'Ptr' as the i-th key of
+   a leaf, re-encoding the page in Scratch */
+static int LeafInsert(char *Page, int i, char *Key, int KeyLen, long Ptr) {
+    struct LeafCursor c;
+    int nkeys = SlotNumKeys(Page), ok = TRUE;
+    char prev[MAXWORDSIZE + 1];
+    int prevlen = 0;
+    long ptr;
+
+    if (i == nkeys) { /* the common case of FlushPage() and bulk loads */
+        if (nkeys % LEAFRESTART != 0) {
+            LeafFind(Page, nkeys - 1, &c);
+            return (LeafAppend(Page, c.Key, c.Len, Key, KeyLen, Ptr));
+        }
+        return (LeafAppend(Page, NULL, 0, Key, KeyLen, Ptr));
+    }
+
+    if (Scratch == NULL) {
+        Scratch = (char *) malloc(PAGESIZE);
+        ck_malloc(Scratch, "Scratch");
+    }
+    SlotInit(Scratch, LeafSymbol, SlotPgNum(Page), SlotLink(Page));
+    for (LeafSeek(Page, 0, &c);; LeafNext(Page, &c)) {
+        if (c.Pos == i) {
+            ok = LeafAppend(Scratch, prev, prevlen, Key, KeyLen, Ptr);
+            memcpy(prev, Key, KeyLen);
+            prevlen = KeyLen;
+        }
+        memcpy(&ptr, Page + c.Off, sizeof(ptr));
+        ok = ok && LeafAppend(Scratch, prev, prevlen, c.Key, c.Len, ptr);
+        memcpy(prev, c.Key, c.Len);
+        prevlen = c.Len;
+        if (!ok || (c.Pos + 1 == nkeys))
+            break;
+    }
+    if (ok)
+        memcpy(Page, Scratch, PAGESIZE);
+    return (ok);
+}
+
+/* inserts the key (Key, KeyLen) with pointer 'Ptr' as the i-th key.
+   Returns FALSE, leaving the page untouched, if it does not fit. */
+int SlotInsert(char *Page, int i, char *Key, int KeyLen, long Ptr) {
+    SLOT heap, nkeys, off;
+    unsigned char len = (unsigned char) KeyLen;
+    char *slot;
+
+    assert(KeyLen <= MAXWORDSIZE);
+    if (IsLeafImage(Page))
+        return (LeafInsert(Page, i, Key, KeyLen, Ptr));
+    if (SlotBytes(Page) + SlotSize(KeyLen) > PAGESIZE)
+        return (FALSE);
+    memcpy(&heap, Page + SP_HEAP, sizeof(heap));
+    nkeys = (SLOT) SlotNumKeys(Page);
+
+    /* append the entry to the key heap */
+    off = heap - (sizeof(Ptr) + 1 + KeyLen);
+    memcpy(Page + off, &Ptr, sizeof(Ptr));
+    memcpy(Page + off + sizeof(Ptr), &len, 1);
+    memcpy(Page + off + sizeof(Ptr) + 1, Key, KeyLen);
+
+    /* open a hole in the slot array */
+    slot = Page + SP_SLOTS + i * sizeof(SLOT);
+    memmove(slot + sizeof(SLOT), slot, (nkeys - i) * sizeof(SLOT));
+    memcpy(slot, &off, sizeof(off));
+
+    nkeys++;
+    memcpy(Page + SP_NKEYS, &nkeys, sizeof(nkeys));
+    memcpy(Page + SP_HEAP, &off, sizeof(off));
+    return (TRUE);
+}
@@ -14,4 +14,9 @@ int pReadCount = 0;   /* number of reads on postings */
 int iCount = 0;       /* number of inserted words */
 int sqCount = 0;      /* number of successful queries */
 int uqCount = 0;      /* number of unsucc. queries */
+int bufHitCount = 0;   /* B-tree page requests served by the buffer pool */
+int bufMissCount = 0;  /* B-tree page requests that went to disk */
+int bufEvictCount = 0; /* pages evicted from the buffer pool */
+int bufWriteCount = 0;   /* fwrite() calls writing back B-tree pages */
+int bufPagesWritten = 0; /* B-tree pages written back */
 
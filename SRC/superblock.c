@@ -0,0 +1,95 @@
+/* superblock.c */
+
+/*  The first PAGESIZE bytes of B-TREE_FILE hold the superblock, which
+    describes the tree; page number p is stored at offset p * PAGESIZE.
+
+    The superblock is read once by dbopen() and kept in "SuperBlk" while
+    the index is open, so that the number of pages, the root and the
+    height of the tree are known without looking at the file.  It is
+    written back by dbsync(), which main() runs after every command (and
+    dbclose() once more at the end), and by "K" when it switches files.
+
+    The fields are written one after the other, in this order:
+        Magic       BTMAGIC, to recognize a B-tree file
+        Version     BTVERSION, the format of the page images
+        PageSize    PAGESIZE the tree was built with
+        NumPages    number of pages in the tree (not counting the
+                    superblock)
+        RootPg      page number of the root
+        Height      number of levels; 1 while the root is a leaf
+        Flags       SB_POSITIONS if the postings keep word positions,
+                    SB_COMPACTING while "K" switches to a new postings
+                    file (see compact.c)
+
+    Whether the postings keep word positions is chosen by "parms" when
+    the index is created, and is then fixed: the superblock overrides
+    "parms" on an existing index.
+*/
+
+#include "def.h"
+
+extern FILE *fpbtree;
+
+void SuperWrite(void);
+
+struct SuperBlock SuperBlk;
+
+/* sets up the superblock of a new, empty file and writes it out,
+   so that the file starts with it before any page is written */
+void SuperInit(void) {
+    SuperBlk.Magic = BTMAGIC;
+    SuperBlk.Version = BTVERSION;
+    SuperBlk.PageSize = PAGESIZE;
+    SuperBlk.NumPages = 0;
+    SuperBlk.RootPg = NULLPAGENO; /* set by CreateRoot() */
+    SuperBlk.Height = 0;
+    SuperBlk.Flags = POSITIONS ? SB_POSITIONS : 0;
+    SuperWrite();
+}
+
+/* reads the superblock of an existing file, checking that the file
+   is a B-tree with the page format and page size of this program */
+void SuperRead(void) {
+    int ok;
+
+    fseek(fpbtree, (long) 0, 0);
+    ok = fread(&SuperBlk.Magic, sizeof(SuperBlk.Magic), 1, fpbtree) &&
+         fread(&SuperBlk.Version, sizeof(SuperBlk.Version), 1, fpbtree) &&
+         fread(&SuperBlk.PageSize, sizeof(SuperBlk.PageSize), 1, fpbtree) &&
+         fread(&SuperBlk.NumPages, sizeof(SuperBlk.NumPages), 1, fpbtree) &&
+         fread(&SuperBlk.RootPg, sizeof(SuperBlk.RootPg), 1, fpbtree) &&
+         fread(&SuperBlk.Height, sizeof(SuperBlk.Height), 1, fpbtree) &&
+         fread(&SuperBlk.Flags, sizeof(SuperBlk.Flags), 1, fpbtree);
+    if (!ok || (SuperBlk.Magic != BTMAGIC)) {
+        printf("B-TREE_FILE is not a B-tree file - remove it to start over\n");
+        exit(-1);
+    }
+    if (SuperBlk.Version != BTVERSION) {
+        printf("B-TREE_FILE has format version %d, expected %d",
+               SuperBlk.Version, BTVERSION);
+        printf(" - remove it and rebuild the index with \"r\"\n");
+        exit(-1);
+    }
+    if (SuperBlk.PageSize != PAGESIZE) {
+        printf("B-TREE_FILE was built with page size %d, parms says %d\n",
+               SuperBlk.PageSize, PAGESIZE);
+        exit(-1);
+    }
+    if (POSITIONS && !(SuperBlk.Flags & SB_POSITIONS))
+        printf("B-TREE_FILE was built without word positions - "
+               "\"positions\" in parms ignored\n");
+    POSITIONS = ((SuperBlk.Flags & SB_POSITIONS) != 0);
+}
+
+/* writes the superblock at the beginning of the file */
+void SuperWrite(void) {
+    fseek(fpbtree, (long) 0, 0);
+    fwrite(&SuperBlk.Magic, sizeof(SuperBlk.Magic), 1, fpbtree);
+    fwrite(&SuperBlk.Version, sizeof(SuperBlk.Version), 1, fpbtree);
+    fwrite(&SuperBlk.PageSize, sizeof(SuperBlk.PageSize), 1, fpbtree);
+    fwrite(&SuperBlk.NumPages, sizeof(SuperBlk.NumPages), 1, fpbtree);
+    fwrite(&SuperBlk.RootPg, sizeof(SuperBlk.RootPg), 1, fpbtree);
+    fwrite(&SuperBlk.Height, sizeof(SuperBlk.Height), 1, fpbtree);
+    fwrite(&SuperBlk.Flags, sizeof(SuperBlk.Flags), 1, fpbtree);
+    fflush(fpbtree);
+}
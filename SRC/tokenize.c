@@ -0,0 +1,140 @@
+/* tokenize.c */
+
+/*  Splits a text into its words, for indexing (insert(), bulkload()
+    and buildIndex()).  A word is a run of letters (isalpha()).
+
+    TokOpen() maps the whole file into memory with mmap(), privately,
+    so that the words can be written in place without touching the
+    file; if it cannot (a pipe, say), it reads the file into memory.
+    TokNext() then walks the memory, with no call to stdio: it skips to
+    the next letter, turns the word to lower case as it goes, through
+    a table, and terminates it with an EOS written over the character
+    that follows it, which the next call puts back.  The word is left
+    where it is, and is not copied: it stays valid until the next call.
+
+    Common words (iscommon()) are looked up as they are in the text:
+    the list has lower case words only, so a word with a capital is
+    never common.  TokNext() tells whether the word had one.
+*/
+
+#include "def.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static unsigned char Lower[256]; /* a letter in lower case, or EOS */
+static int TableMade = FALSE;
+
+/* makes the table, if it is not made yet; the first TokOpen() does,
+   unless threads open streams together, which must call it first */
+void TokInit(void) {
+    int c;
+
+    if (TableMade)
+        return;
+    for (c = 0; c < 256; c++)
+        Lower[c] = isalpha(c) ? tolower(c) : EOS;
+    TableMade = TRUE;
+}
+
+/* reads the file 'fp' into T->Buf, with a byte to spare */
+static void TokRead(struct TokStream *T, FILE *fp) {
+    T->Buf = (char *) malloc(T->Len + 1);
+    ck_malloc(T->Buf, "T->Buf in TokRead()");
+    rewind(fp);
+    if (fread(T->Buf, 1, T->Len, fp) != (size_t) T->Len) {
+        printf("TokRead: cannot read the text\n");
+        exit(-1);
+    }
+    T->Mapped = FALSE;
+}
+
+/* opens the stream 'T' over the text of the file 'fp', at the current
+   position of 'fp' */
+void TokOpen(struct TokStream *T, FILE *fp) {
+    struct stat st;
+    void *p = MAP_FAILED;
+
+    TokInit();
+    fflush(fp);
+    T->Pos = ftell(fp);
+    T->Len = (fstat(fileno(fp), &st) == 0) ? (long) st.st_size : -1;
+    if (T->Len < 0) {
+        printf("TokOpen: cannot find the size of the text\n");
+        exit(-1);
+    }
+    /* the byte after the text must be in the last page mapped, and
+       zero; the file has no pages to map if it is empty */
+    if (T->Len % sysconf(_SC_PAGESIZE) != 0)
+        p = mmap(NULL, (size_t) T->Len + 1, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE, fileno(fp), 0);
+    if (p != MAP_FAILED) {
+        T->Buf = (char *) p;
+        T->Mapped = TRUE;
+    } else
+        TokRead(T, fp);
+    T->Buf[T->Len] = EOS;
+    T->Held = T->Buf[T->Pos];
+}
+
+/* opens the stream 'T' over the bytes 'Start' to 'End' - 1 of the text
+   of the stream 'Whole', which must stay open while 'T' is used.  The
+   byte End becomes the EOS after the text, so that streams over
+   ranges with no byte in common, that one included, can be read by
+   separate threads (see buildIndex.c).  'T' is not to be closed. */
+void TokRange(struct TokStream *T, struct TokStream *Whole, long Start,
+              long End) {
+    T->Buf = Whole->Buf + Start;
+    T->Len = End - Start;
+    T->Pos = 0;
+    T->Mapped = FALSE;
+    T->Buf[T->Len] = EOS;
+    T->Held = T->Buf[0];
+}
+
+/* puts in *Word the next word of 'T', in lower case, and in *Upper
+   whether it had capitals.  Returns
+   TRUE         for a word
+   DOCSTART     for a TAG, which starts a document in TEXTFILE; *Word
+                is then empty
+   EOF          at the end of the text */
+int TokNext(struct TokStream *T, char **Word, int *Upper) {
+    unsigned char *p, *q;
+    unsigned char c;
+    int upper = FALSE;
+
+    T->Buf[T->Pos] = T->Held; /* the character after the last word */
+    for (p = (unsigned char *) T->Buf + T->Pos; Lower[*p] == EOS; p++) {
+        if (p == (unsigned char *) T->Buf + T->Len) {
+            T->Pos = T->Len;
+            T->Held = EOS;
+            return (EOF);
+        }
+        if (*p == TAG) {
+            T->Pos = (char *) p + 1 - T->Buf;
+            T->Held = T->Buf[T->Pos];
+            *Word = T->Buf + T->Len; /* the EOS after the text */
+            *Upper = FALSE;
+            return (DOCSTART);
+        }
+    }
+    for (q = p; (c = Lower[*q]) != EOS; q++)
+        if (c != *q) {
+            *q = c;
+            upper = TRUE;
+        }
+    T->Pos = (char *) q - T->Buf;
+    T->Held = *q;
+    *q = EOS;
+    *Word = (char *) p;
+    *Upper = upper;
+    return (TRUE);
+}
+
+void TokClose(struct TokStream *T) {
+    if (T->Mapped)
+        munmap(T->Buf, (size_t) T->Len + 1);
+    else
+        free(T->Buf);
+    T->Buf = NULL;
+}
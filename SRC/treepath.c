@@ -0,0 +1,103 @@
+/* treepath.c */
+
+/*  Descent from the root to a leaf, shared by insertion, search and
+    the successor/predecessor queries.
+
+    TreeDescend() walks down without recursion, binary-searching each
+    page image in place (SlotSearch(), see slotpage.c), and records the
+    path in a "struct TreePath": for every level the page number and
+    the position taken - the child followed in a nonleaf page (NumKeys
+    for the rightmost child), or the position of the first key >= the
+    search key in the leaf.  The leaf is left pinned, in Path->Frame.
+
+    TreePrevLeaf() moves the path to the previous leaf, for scans that
+    run backwards; forward scans simply follow the leaf chain.
+*/
+
+#include "def.h"
+
+extern char *PinPage(PAGENO Page, int *pFrame);
+extern char *BufImage(int f);
+extern void BufUnpin(int f, int Dirty);
+extern int SlotSearch(char *Page, char *Key, int KeyLen, int *Found);
+extern int SlotNumKeys(char *Page);
+extern long SlotPtr(char *Page, int i);
+extern PAGENO SlotLink(char *Page);
+
+/* the child at position 'Pos' of a nonleaf page image */
+static PAGENO ChildAt(char *Page, int Pos) {
+    if (Pos < SlotNumKeys(Page))
+        return ((PAGENO) SlotPtr(Page, Pos)); /* left child of key Pos */
+    return (SlotLink(Page));                   /* rightmost child */
+}
+
+/* adds page 'PgNum' to the path and pins it */
+static char *PathPush(struct TreePath *Path, PAGENO PgNum) {
+    if (Path->Depth == MAXHEIGHT) {
+        printf("TreeDescend: tree deeper than %d levels\n", MAXHEIGHT);
+        exit(-2);
+    }
+    Path->PgNum[Path->Depth++] = PgNum;
+    return (PinPage(PgNum, &Path->Frame));
+}
+
+/* descends from page 'Root' to the leaf where 'Key' is, or would be.
+   The leaf stays pinned in Path->Frame; Path->Pos[Path->Depth - 1] is
+   the position of the first key >= 'Key' in it, and Path->Found tells
+   whether that key is 'Key' itself. */
+char *TreeDescend(PAGENO Root, char *Key, struct TreePath *Path) {
+    int len = strlen(Key), d;
+    PAGENO child;
+    char *Page;
+
+    Path->Depth = 0;
+    Page = PathPush(Path, Root);
+    while (IsNonLeafImage(Page)) {
+        d = Path->Depth - 1;
+        Path->Pos[d] = SlotSearch(Page, Key, len, &Path->Found);
+        child = ChildAt(Page, Path->Pos[d]);
+        BufUnpin(Path->Frame, FALSE);
+        Page = PathPush(Path, child);
+    }
+    if (!IsLeafImage(Page)) { /* impossible */
+        printf("TreeDescend: Illegal PageType:%c", Page[SP_TYPE]);
+        printf("in page# %d - aborting\n", (int) Path->PgNum[Path->Depth - 1]);
+        exit(-2);
+    }
+    d = Path->Depth - 1;
+    Path->Pos[d] = SlotSearch(Page, Key, len, &Path->Found);
+    return (Page);
+}
+
+/* moves the path to the leaf before the current one, releasing the
+   current leaf; the new leaf is pinned and its position is set past
+   its last key.  Returns NULL, with nothing pinned, at the first leaf,
+   or else the image of the new leaf. */
+char *TreePrevLeaf(struct TreePath *Path) {
+    PAGENO child;
+    char *Page;
+    int d;
+
+    BufUnpin(Path->Frame, FALSE);
+    /* the lowest level where the path can turn left */
+    for (d = Path->Depth - 2; (d >= 0) && (Path->Pos[d] == 0); d--)
+        ;
+    if (d < 0) {
+        Path->Frame = NOFRAME;
+        return (NULL);
+    }
+
+    Path->Depth = d;
+    Page = PathPush(Path, Path->PgNum[d]);
+    Path->Pos[d]--;
+    /* ... then keep to the right all the way down */
+    for (;;) {
+        child = ChildAt(Page, Path->Pos[Path->Depth - 1]);
+        BufUnpin(Path->Frame, FALSE);
+        Page = PathPush(Path, child);
+        Path->Pos[Path->Depth - 1] = SlotNumKeys(Page);
+        if (!IsNonLeafImage(Page))
+            break;
+    }
+    return (Page);
+}
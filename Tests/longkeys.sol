@@ -0,0 +1,631 @@
+Creating postings file...
+Initializing Postings File...
+Creating B-tree file...
+Creating text file...
+Creating document table...
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+	give input file name: 
+*** Inserting ../Tests/longkeys.txt
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+ERROR: key is too long-operation aborted
+offending key:"antichronically"
+ERROR: key is too long-operation aborted
+offending key:"blockheadedness"
+ERROR: key is too long-operation aborted
+offending key:"chamaeleontidae"
+ERROR: key is too long-operation aborted
+offending key:"collegiateness"
+ERROR: key is too long-operation aborted
+offending key:"congenitalness"
+ERROR: key is too long-operation aborted
+offending key:"consolableness"
+ERROR: key is too long-operation aborted
+offending key:"contrabandista"
+ERROR: key is too long-operation aborted
+offending key:"dacryosolenitis"
+ERROR: key is too long-operation aborted
+offending key:"devoutlessness"
+ERROR: key is too long-operation aborted
+offending key:"discourteously"
+ERROR: key is too long-operation aborted
+offending key:"epexegetically"
+ERROR: key is too long-operation aborted
+offending key:"gramineousness"
+ERROR: key is too long-operation aborted
+offending key:"helminthologist"
+ERROR: key is too long-operation aborted
+offending key:"heteromorphism"
+ERROR: key is too long-operation aborted
+offending key:"hydrotachymeter"
+ERROR: key is too long-operation aborted
+offending key:"hyperfederalist"
+ERROR: key is too long-operation aborted
+offending key:"irresolubleness"
+ERROR: key is too long-operation aborted
+offending key:"methodistically"
+ERROR: key is too long-operation aborted
+offending key:"miscommunicate"
+ERROR: key is too long-operation aborted
+offending key:"neighborliness"
+ERROR: key is too long-operation aborted
+offending key:"nonconcurrence"
+ERROR: key is too long-operation aborted
+offending key:"nondisarmament"
+ERROR: key is too long-operation aborted
+offending key:"nonmonarchical"
+ERROR: key is too long-operation aborted
+offending key:"nonpunctuation"
+ERROR: key is too long-operation aborted
+offending key:"parasalpingitis"
+ERROR: key is too long-operation aborted
+offending key:"pathopsychosis"
+ERROR: key is too long-operation aborted
+offending key:"polydimensional"
+ERROR: key is too long-operation aborted
+offending key:"protevangelion"
+ERROR: key is too long-operation aborted
+offending key:"pseudodementia"
+ERROR: key is too long-operation aborted
+offending key:"pyrometallurgy"
+ERROR: key is too long-operation aborted
+offending key:"repetitiousness"
+ERROR: key is too long-operation aborted
+offending key:"rhodymeniaceous"
+ERROR: key is too long-operation aborted
+offending key:"semilogarithmic"
+ERROR: key is too long-operation aborted
+offending key:"subinfeudatory"
+ERROR: key is too long-operation aborted
+offending key:"subrectangular"
+ERROR: key is too long-operation aborted
+offending key:"sulphocyanogen"
+ERROR: key is too long-operation aborted
+offending key:"superconductor"
+ERROR: key is too long-operation aborted
+offending key:"tracheofissure"
+ERROR: key is too long-operation aborted
+offending key:"tympanocervical"
+ERROR: key is too long-operation aborted
+offending key:"underhandedness"
+ERROR: key is too long-operation aborted
+offending key:"unegoistically"
+ERROR: key is too long-operation aborted
+offending key:"unfeasibleness"
+ERROR: key is too long-operation aborted
+offending key:"unprintableness"
+ERROR: key is too long-operation aborted
+offending key:"vaingloriously"
+enter search-word: 
+*** Searching for word acanthopteri 
+found in acanthopteri
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word felonsetting 
+found in felonsetting
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word overruling 
+found in overruling
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word zooparasite 
+found in zooparasite
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word actinidiaceae 
+found in actinidiaceae
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word arundinaceous 
+found in arundinaceous
+Found the key!
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-word: 
+*** Searching for word collegiateness 
+key "collegiateness": not found
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+
+*** Scanning... 
+acanthopteri:1
+acetyliodide:1
+actinidiaceae:1
+adjudgeable:1
+aeronautic:1
+agglutinoid:1
+alcyoniaceae:1
+allotelluric:1
+amelioration:1
+amphiploid:1
+anamnestic:1
+angiasthenia:1
+annerodite:1
+anthelmintic:1
+antimnemonic:1
+antispastic:1
+apocryphal:1
+appressorial:1
+archheresy:1
+aristotelian:1
+arundinaceous:1
+asteroidal:1
+attendantly:1
+autodrainage:1
+avouchment:1
+balanceable:1
+basibranchial:1
+befriender:1
+bernardine:1
+biharmonic:1
+bistipular:1
+boselaphus:1
+branchiate:1
+bromethylene:1
+bunolophodont:1
+caimitillo:1
+campanistic:1
+caprificate:1
+carnalness:1
+cataphoria:1
+celliferous:1
+ceratophyte:1
+cheirospasm:1
+chlamydospore:1
+choreograph:1
+chrysanthemin:1
+circumcentral:1
+clathrulate:1
+coachability:1
+coeloglossum:1
+commencement:1
+compliable:1
+concreteness:1
+convulsional:1
+corpusculum:1
+cotyligerous:1
+countershout:1
+creammaker:1
+crumbliness:1
+cunctative:1
+cyclostoma:1
+decalcomaniac:1
+deerstalking:1
+deliration:1
+dendrologist:1
+deridingly:1
+desolating:1
+dicarpellary:1
+diligentia:1
+disacquaint:1
+disintrench:1
+dissemination:1
+divertibility:1
+dotriacontane:1
+duncishness:1
+echitamine:1
+elaborative:1
+elfishness:1
+enaliosaur:1
+endoplasma:1
+entergogenic:1
+epistolary:1
+ergotamine:1
+etherealness:1
+euthytatic:1
+exculpation:1
+experienced:1
+extractiform:1
+fallibleness:1
+felonsetting:1
+fiendishly:1
+flatulently:1
+folklorism:1
+forestress:1
+franklinite:1
+fulgurating:1
+galvanomagnet:1
+gastrostomize:1
+geomantical:1
+glandaceous:1
+glyptotheca:1
+griddlecake:1
+gymnosporous:1
+halophytism:1
+healthfully:1
+hemispherule:1
+hereditament:1
+hierological:1
+hollandite:1
+homogonous:1
+hotmouthed:1
+hydrazidine:1
+hypocathexis:1
+hypovanadious:1
+ideoplastics:1
+imitatorship:1
+impermanence:1
+impudentness:1
+incognizable:1
+incunabula:1
+indubitably:1
+inferiority:1
+ingurgitate:1
+insecureness:1
+intellectual:1
+interenjoy:1
+internarial:1
+intertinge:1
+intraretinal:1
+involucrum:1
+isomorphous:1
+johnnycake:1
+keratinoid:1
+kriophoros:1
+lamprotype:1
+laurdalite:1
+leptandrin:1
+lichenologist:1
+literalistic:1
+longicaudal:1
+lymphangeitis:1
+maculiferous:1
+malevolence:1
+marantaceous:1
+matchlessness:1
+meethelper:1
+membership:1
+mesembryonic:1
+metahewettite:1
+micrograph:1
+milksoppery:1
+mistakeproof:1
+moneymonger:1
+monophyletic:1
+morisonianism:1
+multicoccous:1
+musculodermic:1
+myringectomy:1
+nasicornous:1
+neurilematic:1
+nimrodical:1
+nonannuitant:1
+nonfraudulent:1
+nonsmoking:1
+nonzoological:1
+numskullism:1
+obtuseness:1
+oedogoniaceae:1
+omniscribent:1
+opinability:1
+organolead:1
+orthopteroid:1
+otacousticon:1
+overassert:1
+overdubbed:1
+overlanguaged:1
+overruling:1
+ovification:1
+paidologist:1
+palicourea:1
+panpsychic:1
+paradeless:1
+parovarium:1
+pedigreeless:1
+pentagamist:1
+perfective:1
+periorbita:1
+perognathinae:1
+petrarchesque:1
+pharmacologic:1
+philopatrian:1
+photerythrous:1
+phrenogram:1
+physostome:1
+pincerlike:1
+planigraph:1
+pleasantry:1
+plumularian:1
+poecilonym:1
+polyrhizous:1
+portentous:1
+postmedian:1
+praetorian:1
+precautional:1
+preconveyal:1
+predivider:1
+preinspection:1
+preoverthrow:1
+presentness:1
+prevacation:1
+probasketball:1
+producible:1
+prologuize:1
+prorealistic:1
+protrusile:1
+pseudoviaduct:1
+pterospora:1
+purpuriferous:1
+quaestuary:1
+quintillian:1
+ramisectomy:1
+rearmament:1
+recompilement:1
+redetention:1
+regimentation:1
+religionist:1
+resiniform:1
+retiringly:1
+revisional:1
+rondellier:1
+sabalaceae:1
+salmagundi:1
+sarcomatoid:1
+scarcelins:1
+schweizerkase:1
+scowlproof:1
+secernment:1
+semibasement:1
+semiteetotal:1
+seraphical:1
+sexradiate:1
+shopkeeping:1
+silverness:1
+skimmerton:1
+snapholder:1
+solventproof:1
+sparrowless:1
+sphacelation:1
+spiritualty:1
+sporogenesis:1
+stainlessness:1
+stegosaurus:1
+stickwater:1
+strainable:1
+strophomenid:1
+subcircuit:1
+subvesicular:1
+supermannish:1
+supertramp:1
+surmounter:1
+symbiotically:1
+syngnathous:1
+tallowmaker:1
+taxonomical:1
+telotrophic:1
+terminatively:1
+tetranitro:1
+themselves:1
+thermostable:1
+threadiness:1
+tiefenthal:1
+tonsillith:1
+transfixture:1
+transwritten:1
+trichocyst:1
+trimyristate:1
+trochleary:1
+tuberculose:1
+ultraviolent:1
+unallayable:1
+unattainably:1
+unblundered:1
+unchildlike:1
+unconcertable:1
+uncorrugated:1
+undeliverable:1
+understress:1
+undiscoursed:1
+uneviscerated:1
+unfulfilling:1
+unheroically:1
+unimportunate:1
+uninvadable:1
+unlitigated:1
+unmodelled:1
+unoratorial:1
+unpetitioned:1
+unreasoning:1
+unrepressed:1
+unsanguineous:1
+unshrinkingly:1
+unstateable:1
+unsweetness:1
+untransient:1
+unwareness:1
+ureterotomy:1
+veneficious:1
+vertebroiliac:1
+virginality:1
+voluntaryist:1
+weaponsmith:1
+whorlflower:1
+woodknacker:1
+xiphisuran:1
+zooparasite:1
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+
+*** Exiting .........
@@ -0,0 +1,282 @@
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase betaine jean, distance 0 
+found in betaine
+found in jean
+-------document #1-----
+canellaceous
+freeholder
+severization
+whetile
+scaphopodous
+toxicological
+piperaceous
+part
+hippuridaceae
+sublapsarianism
+nonenteric
+unloyally
+montiform
+betaine
+jean
+ficklehearted
+peroral
+unshifting
+pontocerebellar
+glacierist
+myotenotomy
+geromorphism
+hepatography
+dermatorrhagia
+sarcolysis
+
+1 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase jean betaine, distance 0 
+found in jean
+found in betaine
+
+0 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase jean betaine, distance 1 
+found in jean
+found in betaine
+-------document #1-----
+canellaceous
+freeholder
+severization
+whetile
+scaphopodous
+toxicological
+piperaceous
+part
+hippuridaceae
+sublapsarianism
+nonenteric
+unloyally
+montiform
+betaine
+jean
+ficklehearted
+peroral
+unshifting
+pontocerebellar
+glacierist
+myotenotomy
+geromorphism
+hepatography
+dermatorrhagia
+sarcolysis
+
+1 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase maffia the fluter, distance 0 
+found in maffia
+"the" is a common word - any word matches it
+found in fluter
+-------document #1-----
+autophoby
+pseudonymousness
+pediatrician
+fruitwise
+banc
+mortacious
+oreophasine
+clat
+overgentle
+blepharism
+airer
+honduranian
+maffia
+a
+fluter
+horologer
+unraveled
+pubal
+lackadaisicalness
+reconvertible
+predisagreement
+gluteal
+fun
+pallwise
+epithymetic
+
+1 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase maffia fluter, distance 0 
+found in maffia
+found in fluter
+
+0 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter phrase: distance=?
+
+*** Phrase maffia fluter, distance 1 
+found in maffia
+found in fluter
+-------document #1-----
+autophoby
+pseudonymousness
+pediatrician
+fruitwise
+banc
+mortacious
+oreophasine
+clat
+overgentle
+blepharism
+airer
+honduranian
+maffia
+a
+fluter
+horologer
+unraveled
+pubal
+lackadaisicalness
+reconvertible
+predisagreement
+gluteal
+fun
+pallwise
+epithymetic
+
+1 document(s) match, of 1 with all the words
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+
+*** Exiting .........
@@ -2,12 +2,19 @@
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -24,12 +31,19 @@ aardwolf
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -38,12 +52,19 @@ k should be positive not -1
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -52,12 +73,19 @@ k should be positive not 0
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -72,12 +100,19 @@ herculean
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -92,12 +127,19 @@ onomatoplasm
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -112,12 +154,19 @@ sesquipedal
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -127,12 +176,19 @@ key: "malloc": not found
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 
@@ -0,0 +1,424 @@
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying jean AND pierre 
+found in jean
+found in pierre
+-------document #1-----
+workmaster
+chamberwoman
+fulgide
+volsteadism
+coronofacial
+irreciprocity
+unplacable
+lip
+jean-pierre
+remarshal
+steelworks
+helge
+highlandish
+murexan
+bonbo
+dicranaceae
+biogeographical
+catonically
+m
+parchment
+uncomprehensive
+usurpative
+paranucleate
+cowardy
+mergence
+
+1 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying (jean OR christophe) AND NOT pierre 
+found in jean
+found in christophe
+found in pierre
+-------document #1-----
+dendrocoele
+thioamide
+poundman
+orthosemidin
+pteromalid
+stoichiometric
+cowperian
+apostatism
+postmillenarianism
+pharyngomycosis
+piperonyl
+tragedial
+mossback
+sexualist
+ubiquitous
+pockwood
+salzfelle
+campylospermous
+epilogize
+thymolphthalein
+trimargarin
+infundibuliform
+bodhi
+cassation
+jean-christophe
+-------document #2-----
+canellaceous
+freeholder
+severization
+whetile
+scaphopodous
+toxicological
+piperaceous
+part
+hippuridaceae
+sublapsarianism
+nonenteric
+unloyally
+montiform
+betaine
+jean
+ficklehearted
+peroral
+unshifting
+pontocerebellar
+glacierist
+myotenotomy
+geromorphism
+hepatography
+dermatorrhagia
+sarcolysis
+-------document #3-----
+undisplanted
+nucleolus
+trinality
+colobin
+patricianship
+disastrousness
+zaparan
+nonpunctual
+jeans
+riverly
+volva
+physostegia
+fluty
+phlobaphene
+endosmometer
+discanonization
+tomentulose
+nonfarm
+coenosteal
+overslight
+chrismal
+webfooter
+christophe
+tricolon
+petrologic
+
+3 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying alex OR vagelis 
+found in alex
+key "vagelis": not found
+-------document #1-----
+rembrandtism
+sinomenine
+inductorium
+alex
+resoothe
+usuary
+sulphatase
+eurythmical
+buffont
+ridgepoled
+salvadoraceous
+cytopathologic
+nonbursting
+clapping
+batholith
+octachord
+tautometric
+clockroom
+eta
+ensate
+spiropentane
+renomination
+unsentimentalist
+schemeful
+remissly
+
+1 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying alex rembrandtism 
+found in alex
+found in rembrandtism
+-------document #1-----
+rembrandtism
+sinomenine
+inductorium
+alex
+resoothe
+usuary
+sulphatase
+eurythmical
+buffont
+ridgepoled
+salvadoraceous
+cytopathologic
+nonbursting
+clapping
+batholith
+octachord
+tautometric
+clockroom
+eta
+ensate
+spiropentane
+renomination
+unsentimentalist
+schemeful
+remissly
+
+1 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying alex AND NOT rembrandtism 
+found in alex
+found in rembrandtism
+
+0 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying NOT alex 
+found in alex
+query: NOT must be ANDed with a positive part
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying the 
+"the" is a common word - dropped from the query
+query: nothing to search for
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying Alex the AND Sinomenine 
+found in alex
+"the" is a common word - dropped from the query
+found in sinomenine
+-------document #1-----
+rembrandtism
+sinomenine
+inductorium
+alex
+resoothe
+usuary
+sulphatase
+eurythmical
+buffont
+ridgepoled
+salvadoraceous
+cytopathologic
+nonbursting
+clapping
+batholith
+octachord
+tautometric
+clockroom
+eta
+ensate
+spiropentane
+renomination
+unsentimentalist
+schemeful
+remissly
+
+1 document(s) match
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter query: 
+*** Querying jean OR 
+found in jean
+query: a word is missing at the end
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+
+*** Exiting .........
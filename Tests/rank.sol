@@ -0,0 +1,203 @@
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-words: k=?
+
+*** Ranking for jean pierre christophe 
+found in jean
+found in pierre
+found in christophe
+-------document #1, score 15.8589-----
+dendrocoele
+thioamide
+poundman
+orthosemidin
+pteromalid
+stoichiometric
+cowperian
+apostatism
+postmillenarianism
+pharyngomycosis
+piperonyl
+tragedial
+mossback
+sexualist
+ubiquitous
+pockwood
+salzfelle
+campylospermous
+epilogize
+thymolphthalein
+trimargarin
+infundibuliform
+bodhi
+cassation
+jean-christophe
+-------document #2, score 15.8589-----
+workmaster
+chamberwoman
+fulgide
+volsteadism
+coronofacial
+irreciprocity
+unplacable
+lip
+jean-pierre
+remarshal
+steelworks
+helge
+highlandish
+murexan
+bonbo
+dicranaceae
+biogeographical
+catonically
+m
+parchment
+uncomprehensive
+usurpative
+paranucleate
+cowardy
+mergence
+-------document #3, score 8.2275-----
+undisplanted
+nucleolus
+trinality
+colobin
+patricianship
+disastrousness
+zaparan
+nonpunctual
+jeans
+riverly
+volva
+physostegia
+fluty
+phlobaphene
+endosmometer
+discanonization
+tomentulose
+nonfarm
+coenosteal
+overslight
+chrismal
+webfooter
+christophe
+tricolon
+petrologic
+
+3 document(s) ranked; 7 of 7 postings scored
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-words: k=?
+
+*** Ranking for Alex the rembrandtism 
+found in alex
+"the" is a common word - dropped from the query
+found in rembrandtism
+-------document #1, score 17.4763-----
+rembrandtism
+sinomenine
+inductorium
+alex
+resoothe
+usuary
+sulphatase
+eurythmical
+buffont
+ridgepoled
+salvadoraceous
+cytopathologic
+nonbursting
+clapping
+batholith
+octachord
+tautometric
+clockroom
+eta
+ensate
+spiropentane
+renomination
+unsentimentalist
+schemeful
+remissly
+
+1 document(s) ranked; 2 of 2 postings scored
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+enter search-words: k=?
+
+*** Ranking for vagelis 
+key "vagelis": not found
+rank: nothing to search for
+
+	*** These are your commands .........
+	"C" to scan the tree
+	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
+	"p" to print a btree page
+	"s" to search, and print the key
+	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
+	">" to print k successors
+	"<" to print k predecessors
+	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
+	"#" to reset and print stats
+	"x" to exit
+
+*** Exiting .........
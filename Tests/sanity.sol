@@ -2,12 +2,19 @@
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -18,12 +25,19 @@ alexander
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -34,12 +48,19 @@ alewife
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -48,12 +69,19 @@ k should be positive not -1
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -62,12 +90,19 @@ k should be positive not -1
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -87,12 +122,19 @@ zebrule
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 word=?
@@ -112,12 +154,19 @@ zealproof
 	*** These are your commands .........
 	"C" to scan the tree
 	"i" to insert
+	"I" to insert a list of files, or a directory
+	"B" to bulk load a list of files into an empty index
 	"p" to print a btree page
 	"s" to search, and print the key
 	"S" to search, and print the key, posting list pairs
+	"Q" to search for an AND/OR/NOT query of words
+	"R" to print the k documents that rank best for words
+	"P" to search for a phrase, or for words near each other
 	">" to print k successors
 	"<" to print k predecessors
 	"T" to print the btree in inorder format
+	"K" to compact the postings file
+	"r" to rebuild the index from the text file
 	"#" to reset and print stats
 	"x" to exit
 